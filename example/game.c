@@ -5,6 +5,7 @@ int main(int argc, char *argv[])
 	int		  day = -1;
 	float		x, y;
 	size_t	   i;
+	size_t	   count = 0;
 	size_t	   light = 255;
 	uint8_t	  loop = 1;
 	SDL_Color	lighting;
@@ -16,11 +17,16 @@ int main(int argc, char *argv[])
 	
 	Window_t *myGame = Window();
 	Entity_t *player = NULL;
-	QTree_t *tree = QTree(screen);
-	CList_t *list = NULL;
+	Entity_t *tiles[1100];
+	Space_t *tree = Split(LTree(screen), QTreeLoose(screen, QTREE_CAPACITY, QTREE_DEPTH));
+	Sweep_t *sweep = Sweep(myGame);
+	CVector_t *list = CVector();
+	Scheduler_t *scheduler = Scheduler();
 	lighting.a = 255;
 
 	srand(SDL_GetTicks64());
+	reserve(ENTITY, 1100);
+	reserve(CLIST, 1100);
 	
 	for (i = 0; i < 400; ++i)
 	{
@@ -37,7 +43,7 @@ int main(int argc, char *argv[])
 				rectb,
 				"./assets/Tiles/tile_0075.png"
 			);
-			tree->qtree.insert(tree, player);
+			tiles[count++] = player;
 		}
 	}
 
@@ -54,7 +60,7 @@ int main(int argc, char *argv[])
 			rectb,
 			"./assets/Tiles/tile_0028.png"
 		);
-		tree->qtree.insert(tree, player);
+		tiles[count++] = player;
 
 		if (rand() % 10 == 0)
 		{
@@ -66,7 +72,7 @@ int main(int argc, char *argv[])
 				rectt,
 				"./assets/Tiles/tile_0259.png"
 			);
-			tree->qtree.insert(tree, player);
+			tiles[count++] = player;
 
 			player = Entity(
 				myGame,
@@ -76,38 +82,42 @@ int main(int argc, char *argv[])
 				rectb,
 				"./assets/Tiles/tile_0232.png"
 			);
-			tree->qtree.insert(tree, player);
+			tiles[count++] = player;
 		}
 	}
 
+	tree->space.vtable->build(tree, tiles, count);
+
 	player = Entity(myGame, 32, 128, LAYER_02 | LAYER_03, rectp, "./assets/Tiles/tile_0024.png");
-	player->entity.setLighting(player, 16, color);
-	player->entity.transition(player, 0, SDL_KEYDOWN, SDLK_d, ACT_01, 0);
-	player->entity.transition(player, 0, SDL_KEYUP, SDLK_d, ACT_03, 0);
-	player->entity.transition(player, 0, SDL_KEYDOWN, SDLK_q, ACT_02, 0);
-	player->entity.transition(player, 0, SDL_KEYUP, SDLK_q, ACT_03, 0);
-	player->entity.transition(player, 0, SDL_KEYDOWN, SDLK_s, ACT_04, 0);
-	player->entity.transition(player, 0, SDL_KEYUP, SDLK_s, ACT_06, 0);
-	player->entity.transition(player, 0, SDL_KEYDOWN, SDLK_z, ACT_05, 0);
-	player->entity.transition(player, 0, SDL_KEYUP, SDLK_z, ACT_06, 0);
-	player->entity.transition(player, 0, SDL_KEYDOWN, SDLK_SPACE, ACT_07, 0);
-	player->entity.transition(player, 0, SDL_KEYUP, SDLK_SPACE, ACT_08, 0);
-	player->entity.transition(player, 0, SDL_KEYDOWN, SDLK_p, NO_ACT, 1);
-	player->entity.transition(player, 1, SDL_KEYDOWN, SDLK_p, NO_ACT, 0);
-	tree->qtree.insert(tree, player);
+	player->entity.vtable->setLighting(player, 16, color);
+	player->entity.vtable->transition(player, 0, SDL_KEYDOWN, SDLK_d, ACT_01, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYUP, SDLK_d, ACT_03, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYDOWN, SDLK_q, ACT_02, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYUP, SDLK_q, ACT_03, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYDOWN, SDLK_s, ACT_04, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYUP, SDLK_s, ACT_06, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYDOWN, SDLK_z, ACT_05, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYUP, SDLK_z, ACT_06, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYDOWN, SDLK_SPACE, ACT_07, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYUP, SDLK_SPACE, ACT_08, 0);
+	player->entity.vtable->transition(player, 0, SDL_KEYDOWN, SDLK_p, NO_ACT, 1);
+	player->entity.vtable->transition(player, 1, SDL_KEYDOWN, SDLK_p, NO_ACT, 0);
+	tree->space.vtable->insert(tree, player);
+	
+	scheduler->scheduler.vtable->addPass(scheduler, NO_LAYER, LAYER_01);
+	scheduler->scheduler.vtable->addPass(scheduler, LAYER_03, LAYER_03);
+	scheduler->scheduler.vtable->addPass(scheduler, NO_LAYER, LAYER_04);
+	scheduler->scheduler.vtable->addPass(scheduler, NO_LAYER, LAYER_05);
 	
 	while (loop)
 	{
-		list = tree->qtree.fetch(tree, screen);
-		list->clist.entityUpdateAndDraw(list, NO_LAYER, LAYER_01);
-		list->clist.entityUpdateAndDraw(list, LAYER_03, LAYER_03);
-		list->clist.entityUpdateAndDraw(list, NO_LAYER, LAYER_04);
-		list->clist.entityUpdateAndDraw(list, NO_LAYER, LAYER_05);
-		list->clist.empty(list);
-		delete(list);
+		tree->space.vtable->fetchVector(tree, screen, LAYER_01 | LAYER_03 | LAYER_04 | LAYER_05, list);
+		sweep->sweep.vtable->runVector(sweep, list, LAYER_03);
+		scheduler->scheduler.vtable->run(scheduler, list);
+		list->cvector.vtable->empty(list);
 		
-		tree->qtree.update(tree);
-		/*tree->qtree.draw(tree, myGame);*/
+		tree->space.vtable->update(tree);
+		/*tree->space.vtable->draw(tree, myGame);*/
 		lighting.r = light / 100;
 		lighting.g = light / 100;
 		lighting.b = light / 100;
@@ -115,13 +125,17 @@ int main(int argc, char *argv[])
 		if (light == 0 || light == 25500)
 			day *= -1;
 		
-		myGame->window.setLighting(myGame, lighting);
+		myGame->window.vtable->setLighting(myGame, lighting);
 		
-		loop = myGame->window.update(myGame);
+		loop = myGame->window.vtable->update(myGame);
 	}
 	
+	delete(scheduler);
+	delete(list);
+	delete(sweep);
 	delete(tree);
 	delete(myGame);
+	release();
 	
 	return 0;
 }
@@ -21,42 +21,242 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
 #include <Base.h>
+#include <Batch.h>
 #include <CList.h>
+#include <CVector.h>
 #include <Entity.h>
-#include <QTree.h>
+#include <Scheduler.h>
 #include <SDL2/SDL.h>
+#include <Space.h>
+#include <Sweep.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <Window.h>
 
-void *new(type_t type, ...)
-{
-	void	   *self = NULL;
-	va_list	arguments;
-	retno_t	retno;
+typedef struct base_slab {
+	char *data;
+	size_t count;
+} base_slab_t;
+
+typedef struct base_pool {
+	void *free;
+	base_slab_t *slab;
+	size_t slabs;
+	size_t size;
+	base_stats_t stats;
+} base_pool_t;
+
+/* One free-list per type, objects are recycled and only given back to the system by release */
+static base_pool_t base_pool[BASE_TYPES];
 
+/**
+	@fn size_t base_t__size(type_t type)
+	@brief Get the object size of a type
+	@param type Class type
+	@return Object size, 0 for an unknown type
+*/
+size_t base_t__size(type_t type)
+{
 	switch (type)
 	{
 	case CLIST:
-		self = calloc(1, sizeof(CList_t));
-		break;
+		return sizeof(CList_t);
 
 	case QTREE:
-		self = calloc(1, sizeof(QTree_t));
-		break;
+		return sizeof(QTree_t);
 
 	case WINDOW:
-		self = calloc(1, sizeof(Window_t));
-		break;
+		return sizeof(Window_t);
 
 	case ENTITY:
-		self = calloc(1, sizeof(Entity_t));
-		break;
+		return sizeof(Entity_t);
+
+	case LTREE:
+		return sizeof(LTree_t);
+
+	case GRID:
+		return sizeof(Grid_t);
+
+	case SPLIT:
+		return sizeof(Split_t);
+
+	case SWEEP:
+		return sizeof(Sweep_t);
+
+	case BATCH:
+		return sizeof(Batch_t);
+
+	case CVECTOR:
+		return sizeof(CVector_t);
+
+	case SCHEDULER:
+		return sizeof(Scheduler_t);
 
 	default:
-		return self;
+		return 0;
+	}
+}
+
+/**
+	@fn base_pool_t *base_t__pool(type_t type)
+	@brief Get the pool of a type
+	@param type Class type
+	@return Pool pointer, NULL for an unknown type
+*/
+base_pool_t *base_t__pool(type_t type)
+{
+	size_t		   index = 0;
+	base_pool_t	  *pool = NULL;
+	
+	if (!base_t__size(type))
+		return pool;
+	
+	while (type >>= 1)
+		++index;
+	
+	pool = &(base_pool[index]);
+	pool->size = base_t__size((type_t) (1 << index));
+	
+	return pool;
+}
+
+/**
+	@fn void base_t__grow(base_pool_t *pool, size_t count)
+	@brief Add a slab of count objects to the pool free-list
+	@param pool Pool pointer
+	@param count Number of objects
+	@return void
+*/
+void base_t__grow(base_pool_t *pool, size_t count)
+{
+	size_t	i;
+	char	  *slab = NULL;
+	
+	slab = malloc(count * pool->size);
+	pool->slab = realloc(pool->slab, (pool->slabs + 1) * sizeof(base_slab_t));
+	pool->slab[pool->slabs].data = slab;
+	pool->slab[pool->slabs++].count = count;
+	
+	for (i = count; i > 0; --i)
+	{
+		*(void **) (slab + (i - 1) * pool->size) = pool->free;
+		pool->free = slab + (i - 1) * pool->size;
+	}
+	
+	pool->stats.capacity += count;
+}
+
+/**
+	@fn uint8_t base_t__owns(base_pool_t *pool, void *self)
+	@brief Tell whether an object lies in one of the pool slabs
+	@param pool Pool pointer
+	@param self Object pointer
+	@return Boolean TRUE if the object came from the pool
+*/
+uint8_t base_t__owns(base_pool_t *pool, void *self)
+{
+	size_t i;
+	
+	for (i = 0; i < pool->slabs; ++i)
+	{
+		if ((char *) self >= pool->slab[i].data &&
+			(char *) self < pool->slab[i].data + pool->slab[i].count * pool->size)
+			return 1;
+	}
+	
+	return 0;
+}
+
+/**
+	@fn void reserve(type_t type, size_t count)
+	@brief Make sure count objects of a type can be live without a system allocation,
+	call it at startup so gameplay frames only recycle objects
+	@param type Class type
+	@param count Number of objects
+	@return void
+*/
+void reserve(type_t type, size_t count)
+{
+	base_pool_t *pool = NULL;
+	
+	pool = base_t__pool(type);
+	
+	if (pool && count > pool->stats.capacity)
+		base_t__grow(pool, count - pool->stats.capacity);
+}
+
+/**
+	@fn base_stats_t stats(type_t type)
+	@brief Get the pool statistics of a type
+	@param type Class type
+	@return Live objects, their high-water mark and the pool capacity
+*/
+base_stats_t stats(type_t type)
+{
+	base_stats_t	 none = { 0, 0, 0 };
+	base_pool_t	  *pool = NULL;
+	
+	pool = base_t__pool(type);
+	
+	return pool ? pool->stats : none;
+}
+
+/**
+	@fn void release(void)
+	@brief Give every pool slab and the CList link slabs back to the system, call it at shutdown
+	@return void
+	
+	@warning Every object must be deleted first, and no other thread may use the pools
+*/
+void release(void)
+{
+	size_t i, j;
+	
+	for (i = 0; i < BASE_TYPES; ++i)
+	{
+		for (j = 0; j < base_pool[i].slabs; ++j)
+			free(base_pool[i].slab[j].data);
+		
+		free(base_pool[i].slab);
+		memset(&(base_pool[i]), 0, sizeof(base_pool_t));
 	}
 	
+	clist_t__release();
+}
+
+/**
+	@fn void *new(type_t type, ...)
+	@brief Take a zeroed object from the type pool and construct it
+	@param type Class type
+	@return Object pointer, NULL for an unknown type
+	
+	@warning Pools are shared without locking, objects are made on one thread
+*/
+void *new(type_t type, ...)
+{
+	void		   *self = NULL;
+	va_list		arguments;
+	retno_t		retno;
+	base_pool_t	*pool = NULL;
+
+	pool = base_t__pool(type);
+	
+	if (!pool)
+		return self;
+	
+	/* Slabs double so delete only checks a few of them */
+	if (!pool->free)
+		base_t__grow(pool, MAX(BASE_SLAB, pool->stats.capacity));
+	
+	self = pool->free;
+	pool->free = *(void **) self;
+	memset(self, 0, pool->size);
+	
+	if (++pool->stats.live > pool->stats.peak)
+		pool->stats.peak = pool->stats.live;
+	
 	va_start(arguments, type);
 	
 	if (type & CLIST)
@@ -68,6 +268,9 @@ void *new(type_t type, ...)
 	if (type & QTREE)
 	{
 		((QTree_t *) self)->qtree.rect = va_arg(arguments, SDL_FRect);
+		((QTree_t *) self)->qtree.size = va_arg(arguments, size_t);
+		((QTree_t *) self)->qtree.depth = va_arg(arguments, size_t);
+		((QTree_t *) self)->qtree.loose = va_arg(arguments, int);
 		retno = qtree_t__ctor((QTree_t *) self);
 		LOG_ERROR(retno, "qtree_t__ctor");
 	}
@@ -90,14 +293,78 @@ void *new(type_t type, ...)
 		LOG_ERROR(retno, "entity_t__ctor");
 	}
 	
+	if (type & LTREE)
+	{
+		((LTree_t *) self)->ltree.rect = va_arg(arguments, SDL_FRect);
+		retno = ltree_t__ctor((LTree_t *) self);
+		LOG_ERROR(retno, "ltree_t__ctor");
+	}
+	
+	if (type & GRID)
+	{
+		((Grid_t *) self)->grid.cell = va_arg(arguments, double);
+		((Grid_t *) self)->grid.buckets = va_arg(arguments, size_t);
+		retno = grid_t__ctor((Grid_t *) self);
+		LOG_ERROR(retno, "grid_t__ctor");
+	}
+	
+	if (type & SPLIT)
+	{
+		((Split_t *) self)->split.fixed = va_arg(arguments, Space_t *);
+		((Split_t *) self)->split.dynamic = va_arg(arguments, Space_t *);
+		retno = split_t__ctor((Split_t *) self);
+		LOG_ERROR(retno, "split_t__ctor");
+	}
+	
+	if (type & SWEEP)
+	{
+		((Sweep_t *) self)->sweep.window = va_arg(arguments, Window_t *);
+		retno = sweep_t__ctor((Sweep_t *) self);
+		LOG_ERROR(retno, "sweep_t__ctor");
+	}
+	
+	if (type & BATCH)
+	{
+		((Batch_t *) self)->batch.layer = va_arg(arguments, layer_t);
+		retno = batch_t__ctor((Batch_t *) self);
+		LOG_ERROR(retno, "batch_t__ctor");
+	}
+	
+	if (type & CVECTOR)
+	{
+		retno = cvector_t__ctor((CVector_t *) self);
+		LOG_ERROR(retno, "cvector_t__ctor");
+	}
+	
+	if (type & SCHEDULER)
+	{
+		retno = scheduler_t__ctor((Scheduler_t *) self);
+		LOG_ERROR(retno, "scheduler_t__ctor");
+	}
+	
 	va_end(arguments);
 	*(type_t *) self = type;
 	
 	return self;
 }
 
+/**
+	@fn void delete(void *self)
+	@brief Destruct an object and give it back to its type pool
+	@param self Object pointer
+	@return void
+	
+	@note Objects that did not come from a pool, like frame lists, are left alone
+*/
 void delete(void *self)
 {
+	base_pool_t *pool = NULL;
+	
+	pool = base_t__pool(*(type_t *) self);
+	
+	if (!pool || !base_t__owns(pool, self))
+		return;
+	
 	if (*(type_t *) self & CLIST)
 		clist_t__dtor((CList_t *) self);
 	
@@ -110,5 +377,28 @@ void delete(void *self)
 	if (*(type_t *) self & ENTITY)
 		entity_t__dtor((Entity_t *) self);
 	
-	free(self);
+	if (*(type_t *) self & LTREE)
+		ltree_t__dtor((LTree_t *) self);
+	
+	if (*(type_t *) self & GRID)
+		grid_t__dtor((Grid_t *) self);
+	
+	if (*(type_t *) self & SPLIT)
+		split_t__dtor((Split_t *) self);
+	
+	if (*(type_t *) self & SWEEP)
+		sweep_t__dtor((Sweep_t *) self);
+	
+	if (*(type_t *) self & BATCH)
+		batch_t__dtor((Batch_t *) self);
+	
+	if (*(type_t *) self & CVECTOR)
+		cvector_t__dtor((CVector_t *) self);
+	
+	if (*(type_t *) self & SCHEDULER)
+		scheduler_t__dtor((Scheduler_t *) self);
+	
+	*(void **) self = pool->free;
+	pool->free = self;
+	pool->stats.live--;
 }
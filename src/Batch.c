@@ -0,0 +1,212 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Batch.c
+*/
+
+#include <Base.h>
+#include <Batch.h>
+#include <SDL2/SDL.h>
+#include <Space.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+	@relates batch_s
+	@fn size_t batch_t__add(Batch_t *self, SDL_FRect rect)
+	@brief Add a query area to the batch
+	@param self Object pointer
+	@param rect Query area
+	@return Query index, used to read its span after run
+*/
+size_t batch_t__add(Batch_t *self, SDL_FRect rect)
+{
+	if (self->batch.count == self->batch.size)
+	{
+		self->batch.size *= 2;
+		self->batch.rect = realloc(self->batch.rect, self->batch.size * sizeof(SDL_FRect));
+		self->batch.start = realloc(self->batch.start, (self->batch.size + 1) * sizeof(size_t));
+	}
+	
+	self->batch.rect[self->batch.count] = rect;
+	
+	return self->batch.count++;
+}
+
+/**
+	@relates batch_s
+	@fn void batch_t__push(Batch_t *self, size_t query, Entity_t *content)
+	@brief Record an element found by a query, called by the spatial indexes
+	@param self Object pointer
+	@param query Query index
+	@param content Element pointer
+	@return void
+*/
+void batch_t__push(Batch_t *self, size_t query, Entity_t *content)
+{
+	if (self->batch.pairs == self->batch.room)
+	{
+		self->batch.room *= 2;
+		self->batch.pair = realloc(self->batch.pair, self->batch.room * sizeof(batch_pair_t));
+		self->batch.result = realloc(self->batch.result, self->batch.room * sizeof(Entity_t *));
+	}
+	
+	self->batch.pair[self->batch.pairs].query = query;
+	self->batch.pair[self->batch.pairs].content = content;
+	self->batch.pairs++;
+}
+
+/**
+	@relates batch_s
+	@fn void batch_t__reserve(Batch_t *self, size_t count)
+	@brief Make room for count more query indexes on top of the active stack,
+	tree indexes keep there the queries still crossing the node they descend in
+	@param self Object pointer
+	@param count Number of indexes
+	@return void
+*/
+void batch_t__reserve(Batch_t *self, size_t count)
+{
+	if (self->batch.used + count <= self->batch.depth)
+		return;
+	
+	while (self->batch.used + count > self->batch.depth)
+		self->batch.depth *= 2;
+	
+	self->batch.active = realloc(self->batch.active, self->batch.depth * sizeof(size_t));
+}
+
+/**
+	@relates batch_s
+	@fn size_t batch_t__run(Batch_t *self, Space_t *space)
+	@brief Answer every query of the batch in one pass over the space,
+	then order the results so each query owns one contiguous span
+	@param self Object pointer
+	@param space Spatial index
+	@return Number of results over all the queries
+	
+	@note Batches holding separate queries can run on separate threads once
+	the space was updated after its last insert or remove, and as long as it
+	is not changed meanwhile. An LTree (alone or in a Split) sorts pending
+	inserts on its first query, so two threads querying it before that
+	update would both write to it.
+*/
+size_t batch_t__run(Batch_t *self, Space_t *space)
+{
+	size_t i;
+	size_t offset;
+	size_t total;
+	
+	self->batch.pairs = 0;
+	self->batch.used = 0;
+	
+	if (self->batch.count)
+		space->space.vtable->query(space, self);
+	
+	/* Counting sort on the query index, start[i] ends up at the first result of query i */
+	memset(self->batch.start, 0, (self->batch.count + 1) * sizeof(size_t));
+	
+	for (i = 0; i < self->batch.pairs; ++i)
+		self->batch.start[self->batch.pair[i].query]++;
+	
+	for (i = 0, offset = 0; i <= self->batch.count; ++i)
+	{
+		total = self->batch.start[i];
+		self->batch.start[i] = offset;
+		offset += total;
+	}
+	
+	for (i = 0; i < self->batch.pairs; ++i)
+		self->batch.result[self->batch.start[self->batch.pair[i].query]++] = self->batch.pair[i].content;
+	
+	for (i = self->batch.count; i > 0; --i)
+		self->batch.start[i] = self->batch.start[i - 1];
+	
+	self->batch.start[0] = 0;
+	
+	return self->batch.pairs;
+}
+
+/**
+	@relates batch_s
+	@fn Entity_t **batch_t__span(Batch_t *self, size_t query, size_t *count)
+	@brief Get the results of a query from the last run
+	@param self Object pointer
+	@param query Query index
+	@param count Receives the number of results
+	@return First result of the query, inside the batch output buffer
+*/
+Entity_t **batch_t__span(Batch_t *self, size_t query, size_t *count)
+{
+	*count = self->batch.start[query + 1] - self->batch.start[query];
+	
+	return self->batch.result + self->batch.start[query];
+}
+
+/**
+	@relates batch_s
+	@fn void batch_t__empty(Batch_t *self)
+	@brief Drop the queries and results, buffers are kept for the next frame
+	@param self Object pointer
+	@return void
+*/
+void batch_t__empty(Batch_t *self)
+{
+	self->batch.count = 0;
+	self->batch.pairs = 0;
+	self->batch.start[0] = 0;
+}
+
+static const batch_vtable_t batch_vtable = {
+	&batch_t__add,
+	&batch_t__push,
+	&batch_t__reserve,
+	&batch_t__run,
+	&batch_t__span,
+	&batch_t__empty
+};
+
+retno_t batch_t__ctor(Batch_t *self)
+{
+	self->batch.size = BATCH_SIZE;
+	self->batch.room = BATCH_SIZE;
+	self->batch.depth = BATCH_SIZE;
+	self->batch.rect = malloc(self->batch.size * sizeof(SDL_FRect));
+	self->batch.start = calloc(self->batch.size + 1, sizeof(size_t));
+	self->batch.pair = malloc(self->batch.room * sizeof(batch_pair_t));
+	self->batch.result = malloc(self->batch.room * sizeof(Entity_t *));
+	self->batch.active = malloc(self->batch.depth * sizeof(size_t));
+	
+	self->batch.vtable = &batch_vtable;
+	
+	return SUCCESS;
+}
+
+retno_t batch_t__dtor(Batch_t *self)
+{
+	free(self->batch.rect);
+	free(self->batch.start);
+	free(self->batch.pair);
+	free(self->batch.result);
+	free(self->batch.active);
+	
+	return SUCCESS;
+}
@@ -24,28 +24,170 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <CList.h>
 #include <Entity.h>
 #include <layer.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <Window.h>
+
+struct clist_slab {
+	clist_slab_t *next;
+	clist_block_t block[CLIST_SLAB];
+};
+
+/* Link blocks are shared by every list, a list made and deleted each frame reuses them.
+   The pool has no lock, lists must stay on one thread */
+static struct {
+	clist_block_t *free;
+	clist_slab_t *slab;
+} clist_pool = { NULL, NULL };
 
 /**
 	@relates clist_s
-	@fn void clist_t__push(CList_t *self, void *content)
-	@brief Head push
+	@fn clist_block_t *clist_t__alloc(void)
+	@brief Take a link block from the shared free-list, a new slab is allocated when it is empty
+	@return Block pointer
+	
+	@warning Blocks are shared without locking, lists must stay on one thread
+*/
+clist_block_t *clist_t__alloc(void)
+{
+	size_t			 i;
+	clist_block_t	  *block = NULL;
+	clist_slab_t	   *slab = NULL;
+	
+	if (!clist_pool.free)
+	{
+		slab = malloc(sizeof(clist_slab_t));
+		slab->next = clist_pool.slab;
+		clist_pool.slab = slab;
+		
+		for (i = 0; i < CLIST_SLAB; ++i)
+		{
+			slab->block[i].next = clist_pool.free;
+			clist_pool.free = &(slab->block[i]);
+		}
+	}
+	
+	block = clist_pool.free;
+	clist_pool.free = block->next;
+	block->intrusive = 0;
+	
+	return block;
+}
+
+/**
+	@relates clist_s
+	@fn void clist_t__release(void)
+	@brief Give the link slabs back to the system, call it at shutdown
+	@return void
+	
+	@warning Every list using pool links must be deleted first, and no other thread may use lists
+*/
+void clist_t__release(void)
+{
+	clist_slab_t *slab = NULL;
+	
+	while (clist_pool.slab)
+	{
+		slab = clist_pool.slab;
+		clist_pool.slab = slab->next;
+		free(slab);
+	}
+	
+	clist_pool.free = NULL;
+}
+
+/**
+	@relates clist_s
+	@fn void clist_t__unlink(CList_t *self, clist_block_t *block)
+	@brief Remove a link in constant time, pool blocks go back to the free-list
 	@param self Object pointer
-	@param content Element pointer
+	@param block Link from link, attach or iter
 	@return void
 */
-void clist_t__push(CList_t *self, void *content)
+void clist_t__unlink(CList_t *self, clist_block_t *block)
 {
-	clist_block_t *block = NULL;
+	if (block->prev)
+		block->prev->next = block->next;
+	else
+		self->clist.head = block->next;
 	
-	block = calloc(1, sizeof(clist_block_t));
+	if (block->next)
+		block->next->prev = block->prev;
 	
+	block->prev = NULL;
+	block->next = NULL;
+	
+	if (!block->intrusive)
+	{
+		block->next = clist_pool.free;
+		clist_pool.free = block;
+	}
+}
+
+/**
+	@relates clist_s
+	@fn void clist_t__attach(CList_t *self, clist_block_t *block, void *content)
+	@brief Head push of a link owned by the caller, usually embedded in the element,
+	nothing is allocated and unlink removes it in constant time
+	@param self Object pointer
+	@param block Caller link, not in any list
+	@param content Element pointer
+	@return void
+*/
+void clist_t__attach(CList_t *self, clist_block_t *block, void *content)
+{
 	block->content = content;
+	block->intrusive = 1;
+	block->prev = NULL;
 	block->next = self->clist.head;
 	
+	if (block->next)
+		block->next->prev = block;
+	
 	self->clist.head = block;
 }
 
+/**
+	@relates clist_s
+	@fn clist_block_t *clist_t__link(CList_t *self, void *content)
+	@brief Head push returning the link as a removal handle for unlink
+	@param self Object pointer
+	@param content Element pointer
+	@return Link pointer
+*/
+clist_block_t *clist_t__link(CList_t *self, void *content)
+{
+	clist_block_t *block = NULL;
+	
+	/* Frame links are dropped with the arena, like caller links they are never recycled */
+	if (self->clist.frame)
+	{
+		block = self->clist.frame->window.vtable->frameAlloc(self->clist.frame, sizeof(clist_block_t));
+		self->clist.vtable->attach(self, block, content);
+		
+		return block;
+	}
+	
+	block = clist_t__alloc();
+	self->clist.vtable->attach(self, block, content);
+	block->intrusive = 0;
+	
+	return block;
+}
+
+/**
+	@relates clist_s
+	@fn void clist_t__push(CList_t *self, void *content)
+	@brief Head push
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+*/
+void clist_t__push(CList_t *self, void *content)
+{
+	self->clist.vtable->link(self, content);
+}
+
 /**
 	@relates clist_s
 	@fn void *clist_t__pop(CList_t *self)
@@ -55,17 +197,13 @@ void clist_t__push(CList_t *self, void *content)
 */
 void *clist_t__pop(CList_t *self)
 {
-	void			 *content = NULL;
-	clist_block_t	*block = NULL;
+	void *content = NULL;
 	
 	if (!self->clist.head)
 		return content;
 	
-	block = self->clist.head;
-	content = block->content;
-	self->clist.head = block->next;
-	
-	free(block);
+	content = self->clist.head->content;
+	self->clist.vtable->unlink(self, self->clist.head);
 	
 	return content;
 }
@@ -96,7 +234,7 @@ void *clist_t__iter(CList_t *self, clist_block_t **block)
 /**
 	@relates clist_s
 	@fn void clist_t__remove(CList_t *self, void *content)
-	@brief Remove element
+	@brief Remove element, a linear scan, keep the link handle and use unlink instead on long lists
 	@param self Object pointer
 	@param content Element pointer
 	@return void
@@ -104,24 +242,14 @@ void *clist_t__iter(CList_t *self, clist_block_t **block)
 void clist_t__remove(CList_t *self, void *content)
 {
 	clist_block_t *block = NULL;
-	clist_block_t *prev = NULL;
 	
-	block = self->clist.head;
-	while (block)
+	for (block = self->clist.head; block; block = block->next)
 	{
 		if (block->content == content)
 		{
-			if (prev)
-				prev->next = block->next;
-			else
-				self->clist.head = block->next;
-			
-			free(block);
+			self->clist.vtable->unlink(self, block);
 			
 			return;
-		} else {
-			prev = block;
-			block = block->next;
 		}
 	}
 }
@@ -137,9 +265,9 @@ void clist_t__empty(CList_t *self)
 {
 	void *content = NULL;
 	
-	content = self->clist.pop(self);
+	content = self->clist.vtable->pop(self);
 	while (content)
-		content = self->clist.pop(self);
+		content = self->clist.vtable->pop(self);
 }
 
 /**
@@ -157,30 +285,37 @@ void clist_t__entityUpdateAndDraw(CList_t *self, layer_t updateLayer, layer_t dr
 	Entity_t		 *content = NULL;
 	clist_block_t	*block = NULL;
 	
-	content = self->clist.iter(self, &block);
+	content = self->clist.vtable->iter(self, &block);
 	while (content)
 	{
-		layer = content->entity.getLayer(content);
+		layer = content->entity.vtable->getLayer(content);
 		
 		if (layer & updateLayer)
-			content->entity.update(content);
+			content->entity.vtable->update(content);
 
 		if (layer & drawLayer)
-			content->entity.draw(content);
+			content->entity.vtable->draw(content);
 		
-		content = self->clist.iter(self, &block);
+		content = self->clist.vtable->iter(self, &block);
 	}
 }
 
+static const clist_vtable_t clist_vtable = {
+	&clist_t__pop,
+	&clist_t__empty,
+	&clist_t__push,
+	&clist_t__remove,
+	&clist_t__attach,
+	&clist_t__unlink,
+	&clist_t__link,
+	&clist_t__iter,
+	&clist_t__entityUpdateAndDraw
+};
+
 retno_t clist_t__ctor(CList_t *self)
 {
 	self->clist.head = NULL;
-	self->clist.push = &clist_t__push;
-	self->clist.pop = &clist_t__pop;
-	self->clist.iter = &clist_t__iter;
-	self->clist.remove = &clist_t__remove;
-	self->clist.empty = &clist_t__empty;
-	self->clist.entityUpdateAndDraw = &clist_t__entityUpdateAndDraw;
+	self->clist.vtable = &clist_vtable;
 	
 	return SUCCESS;
 }
@@ -189,11 +324,11 @@ retno_t clist_t__dtor(CList_t *self)
 {
 	void *content = NULL;
 	
-	content = self->clist.pop(self);
+	content = self->clist.vtable->pop(self);
 	while (content)
 	{
 		delete(content);
-		content = self->clist.pop(self);
+		content = self->clist.vtable->pop(self);
 	}
 	
 	return SUCCESS;
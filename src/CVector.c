@@ -0,0 +1,243 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file CVector.c
+*/
+
+#include <Base.h>
+#include <CVector.h>
+#include <Entity.h>
+#include <layer.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+	@relates cvector_s
+	@fn void cvector_t__reserve(CVector_t *self, size_t size)
+	@brief Make room for size elements
+	@param self Object pointer
+	@param size Wanted capacity
+	@return void
+*/
+void cvector_t__reserve(CVector_t *self, size_t size)
+{
+	if (size <= self->cvector.size)
+		return;
+	
+	while (self->cvector.size < size)
+		self->cvector.size *= 2;
+	
+	self->cvector.content = realloc(self->cvector.content, self->cvector.size * sizeof(void *));
+}
+
+/**
+	@relates cvector_s
+	@fn void cvector_t__push(CVector_t *self, void *content)
+	@brief Tail push, the capacity doubles when full
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+*/
+void cvector_t__push(CVector_t *self, void *content)
+{
+	if (self->cvector.count == self->cvector.size)
+		self->cvector.vtable->reserve(self, self->cvector.count + 1);
+	
+	self->cvector.content[self->cvector.count++] = content;
+}
+
+/**
+	@relates cvector_s
+	@fn void *cvector_t__pop(CVector_t *self)
+	@brief Tail pop
+	@param self Object pointer
+	@return Tail element pointer
+*/
+void *cvector_t__pop(CVector_t *self)
+{
+	if (!self->cvector.count)
+		return NULL;
+	
+	return self->cvector.content[--self->cvector.count];
+}
+
+/**
+	@relates cvector_s
+	@fn void *cvector_t__get(CVector_t *self, size_t index)
+	@brief Get an element
+	@param self Object pointer
+	@param index Element index
+	@return Element pointer, NULL out of range
+*/
+void *cvector_t__get(CVector_t *self, size_t index)
+{
+	if (index >= self->cvector.count)
+		return NULL;
+	
+	return self->cvector.content[index];
+}
+
+/**
+	@relates cvector_s
+	@fn void *cvector_t__iter(CVector_t *self, size_t *index)
+	@brief Iterate vector elements, start with index at 0
+	@param self Object pointer
+	@param index Position, moved past the returned element
+	@return Element pointer, NULL at the end
+*/
+void *cvector_t__iter(CVector_t *self, size_t *index)
+{
+	if (*index >= self->cvector.count)
+		return NULL;
+	
+	return self->cvector.content[(*index)++];
+}
+
+/**
+	@relates cvector_s
+	@fn void *cvector_t__removeAt(CVector_t *self, size_t index)
+	@brief Remove an element in constant time, the last element takes its place
+	@param self Object pointer
+	@param index Element index
+	@return Removed element pointer, NULL out of range
+*/
+void *cvector_t__removeAt(CVector_t *self, size_t index)
+{
+	void *content = NULL;
+	
+	if (index >= self->cvector.count)
+		return content;
+	
+	content = self->cvector.content[index];
+	self->cvector.content[index] = self->cvector.content[--self->cvector.count];
+	
+	return content;
+}
+
+/**
+	@relates cvector_s
+	@fn void cvector_t__remove(CVector_t *self, void *content)
+	@brief Remove element, the last element takes its place
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+*/
+void cvector_t__remove(CVector_t *self, void *content)
+{
+	size_t i;
+	
+	for (i = 0; i < self->cvector.count; ++i)
+	{
+		if (self->cvector.content[i] == content)
+		{
+			self->cvector.vtable->removeAt(self, i);
+			
+			return;
+		}
+	}
+}
+
+/**
+	@relates cvector_s
+	@fn void cvector_t__sort(CVector_t *self, int (*compare)(const void *, const void *))
+	@brief Sort the elements
+	@param self Object pointer
+	@param compare qsort comparison, called with pointers to element pointers
+	@return void
+*/
+void cvector_t__sort(CVector_t *self, int (*compare)(const void *, const void *))
+{
+	qsort(self->cvector.content, self->cvector.count, sizeof(void *), compare);
+}
+
+/**
+	@relates cvector_s
+	@fn void cvector_t__empty(CVector_t *self)
+	@brief Empty CVector, the capacity is kept
+	@param self Object pointer
+	@return void
+*/
+void cvector_t__empty(CVector_t *self)
+{
+	self->cvector.count = 0;
+}
+
+/**
+	@relates cvector_s
+	@fn void cvector_t__entityUpdateAndDraw(CVector_t *self, layer_t updateLayer, layer_t drawLayer)
+	@brief Update and draw entities selected by layer
+	@param self Object pointer
+	@param updateLayer Layers to update
+	@param drawLayer Layers to draw
+	@return void
+*/
+void cvector_t__entityUpdateAndDraw(CVector_t *self, layer_t updateLayer, layer_t drawLayer)
+{
+	size_t	   i;
+	layer_t	  layer = NO_LAYER;
+	Entity_t	 *content = NULL;
+	
+	for (i = 0; i < self->cvector.count; ++i)
+	{
+		content = self->cvector.content[i];
+		layer = content->entity.vtable->getLayer(content);
+		
+		if (layer & updateLayer)
+			content->entity.vtable->update(content);
+
+		if (layer & drawLayer)
+			content->entity.vtable->draw(content);
+	}
+}
+
+static const cvector_vtable_t cvector_vtable = {
+	&cvector_t__pop,
+	&cvector_t__get,
+	&cvector_t__iter,
+	&cvector_t__removeAt,
+	&cvector_t__empty,
+	&cvector_t__push,
+	&cvector_t__remove,
+	&cvector_t__reserve,
+	&cvector_t__sort,
+	&cvector_t__entityUpdateAndDraw
+};
+
+retno_t cvector_t__ctor(CVector_t *self)
+{
+	self->cvector.count = 0;
+	self->cvector.size = CVECTOR_SIZE;
+	self->cvector.content = malloc(self->cvector.size * sizeof(void *));
+	
+	self->cvector.vtable = &cvector_vtable;
+	
+	return SUCCESS;
+}
+
+retno_t cvector_t__dtor(CVector_t *self)
+{
+	size_t i;
+	
+	for (i = 0; i < self->cvector.count; ++i)
+		delete(self->cvector.content[i]);
+	
+	free(self->cvector.content);
+	
+	return SUCCESS;
+}
@@ -21,13 +21,15 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
 #include <Base.h>
+#include <float.h>
 #include <CList.h>
 #include <Entity.h>
-#include <QTree.h>
 #include <SDL2/SDL.h>
-#include <SDL2/SDL_image.h>
+#include <Space.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <Sweep.h>
 #include <Window.h>
 
 /**
@@ -39,7 +41,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 void entity_t__draw(Entity_t *self)
 {
-	self->entity.window->window.putOnCamera(self->entity.window, self);
+	self->entity.window->window.vtable->putOnCamera(self->entity.window, self);
 }
 
 /**
@@ -64,39 +66,39 @@ CList_t *entity_t__states(Entity_t *self)
 	successor = CList();
 	
 	elem = self->entity.state;
-	list->clist.push(list, elem);
-	successor->clist.push(successor, elem);
+	list->clist.vtable->push(list, elem);
+	successor->clist.vtable->push(successor, elem);
 	
-	elem = successor->clist.pop(successor);
+	elem = successor->clist.vtable->pop(successor);
 	while (elem)
 	{
 		transblock = NULL;
-		transition = elem->transition->clist.iter(elem->transition, &transblock);
+		transition = elem->transition->clist.vtable->iter(elem->transition, &transblock);
 		
 		while (transition)
 		{
 			flag = 0;
 			stateblock = NULL;
-			state = list->clist.iter(list, &stateblock);
+			state = list->clist.vtable->iter(list, &stateblock);
 			
 			while (state)
 			{
 				if (state == transition->to)
 					flag = 1;
 				
-				state = list->clist.iter(list, &stateblock);
+				state = list->clist.vtable->iter(list, &stateblock);
 			}
 			
 			if (!flag)
 			{
-				list->clist.push(list, transition->to);
-				successor->clist.push(successor, transition->to);
+				list->clist.vtable->push(list, transition->to);
+				successor->clist.vtable->push(successor, transition->to);
 			}
 			
-			transition = elem->transition->clist.iter(elem->transition, &transblock);
+			transition = elem->transition->clist.vtable->iter(elem->transition, &transblock);
 		}
 		
-		elem = successor->clist.pop(successor);
+		elem = successor->clist.vtable->pop(successor);
 	}
 	
 	delete(successor);
@@ -129,8 +131,8 @@ void entity_t__transition(Entity_t *self, uint8_t from, uint32_t type, int32_t s
 	transition->sym = sym;
 	transition->action = action;
 	
-	states = self->entity.states(self);
-	elem = states->clist.iter(states, &block);
+	states = self->entity.vtable->states(self);
+	elem = states->clist.vtable->iter(states, &block);
 	
 	while (elem)
 	{
@@ -139,7 +141,7 @@ void entity_t__transition(Entity_t *self, uint8_t from, uint32_t type, int32_t s
 			ptrto = elem;
 			elem = NULL;
 		} else
-			elem = states->clist.iter(states, &block);
+			elem = states->clist.vtable->iter(states, &block);
 	}
 	
 	if (!ptrto)
@@ -151,54 +153,178 @@ void entity_t__transition(Entity_t *self, uint8_t from, uint32_t type, int32_t s
 	
 	transition->to = ptrto;
 	
-	elem = states->clist.pop(states);
+	elem = states->clist.vtable->pop(states);
 	while(elem)
 	{
 		if (elem->id == from)
-			elem->transition->clist.push(elem->transition, transition);
+			elem->transition->clist.vtable->push(elem->transition, transition);
 		
-		elem = states->clist.pop(states);
+		elem = states->clist.vtable->pop(states);
 	}
 	
 	delete(states);
 }
 
+/**
+	@relates entity_s
+	@fn void entity_t__span(float from, float size, float start, float end, float move, float *entry, float *exit)
+	@brief Get the times a moving segment enters and leaves another one
+	@param from Moving segment start
+	@param size Moving segment size
+	@param start Other segment start
+	@param end Other segment end
+	@param move Moving segment displacement
+	@param entry Entry time
+	@param exit Exit time
+	@return void
+*/
+void entity_t__span(float from, float size, float start, float end, float move, float *entry, float *exit)
+{
+	if (move > 0)
+	{
+		*entry = (start - (from + size)) / move;
+		*exit = (end - from) / move;
+	} else if (move < 0)
+	{
+		*entry = (end - from) / move;
+		*exit = (start - (from + size)) / move;
+	} else if (from < end && start < from + size)
+	{
+		*entry = -FLT_MAX;
+		*exit = FLT_MAX;
+	} else
+	{
+		*entry = FLT_MAX;
+		*exit = -FLT_MAX;
+	}
+}
+
+/**
+	@relates entity_s
+	@fn void entity_t__hit(Entity_t *content, void *data)
+	@brief Space visit callback keeping the earliest time of impact of a moving hitbox
+	@param content Element pointer
+	@param data entity_hit_t pointer
+	@return void
+	
+	@note Hitboxes overlapping deeper than ENTITYSKIN are ignored, so entities can leave them
+*/
+void entity_t__hit(Entity_t *content, void *data)
+{
+	float			entry[2];
+	float			exit[2];
+	float			time;
+	uint8_t		  axis;
+	SDL_FRect		rect;
+	entity_hit_t	 *hit = NULL;
+	
+	hit = data;
+	
+	if (content == hit->self)
+		return;
+	
+	rect = content->entity.vtable->getHitbox(content);
+	entity_t__span(hit->rect.x, hit->rect.w, rect.x, rect.x + rect.w, hit->move.x, &entry[0], &exit[0]);
+	entity_t__span(hit->rect.y, hit->rect.h, rect.y, rect.y + rect.h, hit->move.y, &entry[1], &exit[1]);
+	
+	axis = entry[1] > entry[0];
+	time = entry[axis];
+	
+	if (time >= MIN(exit[0], exit[1]) || time >= hit->time || MIN(exit[0], exit[1]) <= 0)
+		return;
+	
+	if (time < 0)
+	{
+		if (-time * fabs(axis ? hit->move.y : hit->move.x) > ENTITYSKIN)
+			return;
+		
+		time = 0;
+	}
+	
+	hit->time = time;
+	hit->axis = axis + 1;
+}
+
+/**
+	@relates entity_s
+	@fn void entity_t__gather(Entity_t *content, void *data)
+	@brief Space visit callback keeping an element for the slide then testing it
+	@param content Element pointer
+	@param data entity_hit_t pointer
+	@return void
+	
+	@note Elements past the hit buffer are kept in the frame arena of the entity window
+*/
+void entity_t__gather(Entity_t *content, void *data)
+{
+	Entity_t		**other = NULL;
+	Window_t		 *window = NULL;
+	entity_hit_t	 *hit = NULL;
+	
+	hit = data;
+	
+	if (content == hit->self)
+		return;
+	
+	if (hit->count == hit->size)
+	{
+		window = hit->self->entity.window;
+		other = window->window.vtable->frameAlloc(window, 2 * hit->size * sizeof(Entity_t *));
+		memcpy(other, hit->other, hit->count * sizeof(Entity_t *));
+		hit->other = other;
+		hit->size *= 2;
+	}
+	
+	hit->other[hit->count++] = content;
+	
+	entity_t__hit(content, data);
+}
+
 /**
 	@relates entity_s
 	@fn uint8_t entity_t__update(Entity_t *self)
 	@brief Update Entity internal automata
 	@param self Object pointer
 	@return Current state id of the Entity automata
+	
+	@note Contacts set by a broad phase are tested instead of querying the space, once.
+	Moves stop at their first impact and slide along the hit side.
 */
 uint8_t entity_t__update(Entity_t *self)
 {
-	uint8_t				flag = 0;
-	CList_t				*list = NULL;
-	QTree_t				*qtree = NULL;
-	Entity_t			   *elem = NULL;
+	size_t				 i;
+	Space_t				*space = NULL;
 	uint64_t			   deltatime = 0;
 	Window_t			   *window = NULL;
 	action_t			   action = NO_ACT;
 	SDL_FRect			  area;
 	SDL_FRect			  rect;
+	SDL_FPoint			 move;
 	SDL_Event			  event;
-	SDL_FRect			  elemrect;
+	entity_hit_t		   hit;
 	clist_block_t		  *block = NULL;
 	entity_state_t		 *state = NULL;
 	entity_transition_t	*transition = NULL;
 
 	window = self->entity.window;
-	event = window->window.getEvent(window);
+	event = window->window.vtable->getEvent(window);
 	state = self->entity.state;
-	deltatime = window->window.getDeltatime(window);
-	rect = self->entity.getHitbox(self);
-	area = self->entity.getTextureRect(self);
-	area.x -= area.w;
-	area.y -= area.h;
-	area.w *= 3;
-	area.h *= 3;
-	
-	transition = state->transition->clist.iter(state->transition, &block);
+	deltatime = window->window.vtable->getDeltatime(window);
+	space = self->entity.vtable->getSpace(self);
+	rect = self->entity.vtable->getHitbox(self);
+	area = self->entity.vtable->getTextureRect(self);
+	
+	if (space && space->space.loose)
+		area = rect;
+	else
+	{
+		area.x -= area.w;
+		area.y -= area.h;
+		area.w *= 3;
+		area.h *= 3;
+	}
+	
+	transition = state->transition->clist.vtable->iter(state->transition, &block);
 	while (transition)
 	{
 		if (transition->type == event.type &&
@@ -208,7 +334,7 @@ uint8_t entity_t__update(Entity_t *self)
 			self->entity.state = transition->to;
 			transition = NULL;
 		} else
-			transition = state->transition->clist.iter(state->transition, &block);
+			transition = state->transition->clist.vtable->iter(state->transition, &block);
 	}
 	
 	if (action & ACT_01)
@@ -230,71 +356,166 @@ uint8_t entity_t__update(Entity_t *self)
 		self->entity.delta.y = 0.0;
 
 	if (action & ACT_07)
-		self->entity.delta.s = 2.0;
+		self->entity.delta.s = ENTITYBOOST;
 	
 	if (action & ACT_08)
 		self->entity.delta.s = 1.0;
 
-	rect.x += self->entity.delta.x * self->entity.delta.s * deltatime;
-	rect.y += self->entity.delta.y * self->entity.delta.s * deltatime;
-	area.x += self->entity.delta.x * self->entity.delta.s * deltatime;
-	area.y += self->entity.delta.y * self->entity.delta.s * deltatime;
-	qtree = self->entity.getQTree(self);
-
-	if (qtree)
-		list = qtree->qtree.fetch(qtree, area);
-
-	if (list)
+	move.x = self->entity.delta.x * self->entity.delta.s * deltatime;
+	move.y = self->entity.delta.y * self->entity.delta.s * deltatime;
+	area.x += MIN(move.x, 0);
+	area.y += MIN(move.y, 0);
+	area.w += fabs(move.x);
+	area.h += fabs(move.y);
+	hit.self = self;
+	hit.rect = rect;
+	hit.move = move;
+	hit.time = 1;
+	hit.axis = 0;
+	hit.count = 0;
+	hit.size = ENTITYCONTACTS;
+	hit.other = hit.buffer;
+
+	/* Contacts of an older run point in a buffer the sweep may have moved */
+	if (self->entity.contact.other && self->entity.contact.run == sweep_t__clock())
 	{
-		elem = list->clist.pop(list);
-		while (elem)
-		{
-			if (elem != self &&
-				elem->entity.getLayer(elem) & self->entity.getLayer(self))
-			{
-				elemrect = elem->entity.getHitbox(elem);
-				flag |= SDL_HasIntersectionF(&elemrect, &rect);
-			}
-			
-			elem = list->clist.pop(list);
-		}
+		hit.other = self->entity.contact.other;
+		hit.count = self->entity.contact.count;
 		
-		delete(list);
-	}
-
-	if (!flag)
-		self->entity.setDeltaPosition(
-			self,
-			self->entity.delta.x * self->entity.delta.s * deltatime,
-			self->entity.delta.y * self->entity.delta.s * deltatime
+		for (i = 0; i < hit.count; ++i)
+			entity_t__hit(hit.other[i], &hit);
+		
+		self->entity.vtable->setContacts(self, self->entity.contact.run, NULL, 0);
+	} else if (space)
+		space->space.vtable->visit(
+			space,
+			area,
+			self->entity.vtable->getLayer(self),
+			&entity_t__gather,
+			&hit
 		);
 	
+	/* The move stops at the impact then slides along the hit side with the same candidates */
+	if (hit.axis)
+	{
+		hit.rect.x += move.x * hit.time;
+		hit.rect.y += move.y * hit.time;
+		hit.move.x = hit.axis == 1 ? 0 : move.x * (1 - hit.time);
+		hit.move.y = hit.axis == 2 ? 0 : move.y * (1 - hit.time);
+		move.x *= hit.time;
+		move.y *= hit.time;
+		hit.time = 1;
+		hit.axis = 0;
+		
+		for (i = 0; i < hit.count; ++i)
+			entity_t__hit(hit.other[i], &hit);
+		
+		move.x += hit.move.x * hit.time;
+		move.y += hit.move.y * hit.time;
+	}
+	
+	self->entity.vtable->setDeltaPosition(self, move.x, move.y);
+	
 	return self->entity.state->id;
 }
 
 /**
 	@relates entity_s
-	@fn QTree_t *entity_t__getQTree(Entity_t *self)
-	@brief Get entity qtree
+	@fn Space_t *entity_t__getSpace(Entity_t *self)
+	@brief Get entity spatial index
 	@param self Object pointer
-	@return Entity qtree
+	@return Entity spatial index
 */
-QTree_t *entity_t__getQTree(Entity_t *self)
+Space_t *entity_t__getSpace(Entity_t *self)
 {
-	return self->entity.qtree;
+	return self->entity.space;
 }
 
 /**
 	@relates entity_s
-	@fn void entity_t__setQTree(Entity_t *self, QTree_t *qtree)
-	@brief Set entity qtree
+	@fn void entity_t__setSpace(Entity_t *self, Space_t *space)
+	@brief Set entity spatial index
 	@param self Object pointer
-	@param qtree New qtree pointer
+	@param space New spatial index pointer
 	@return void
 */
-void entity_t__setQTree(Entity_t *self, QTree_t *qtree)
+void entity_t__setSpace(Entity_t *self, Space_t *space)
 {
-	self->entity.qtree = qtree;
+	self->entity.space = space;
+}
+
+/**
+	@relates entity_s
+	@fn entity_node_t entity_t__getNode(Entity_t *self)
+	@brief Get entity place in its spatial index
+	@param self Object pointer
+	@return Entity leaf and slot
+*/
+entity_node_t entity_t__getNode(Entity_t *self)
+{
+	return self->entity.node;
+}
+
+/**
+	@relates entity_s
+	@fn void entity_t__setNode(Entity_t *self, Space_t *leaf, size_t slot)
+	@brief Set entity place in its spatial index
+	@param self Object pointer
+	@param leaf Node holding the entity
+	@param slot Content slot in the node
+	@return void
+*/
+void entity_t__setNode(Entity_t *self, Space_t *leaf, size_t slot)
+{
+	self->entity.node.leaf = leaf;
+	self->entity.node.slot = slot;
+}
+
+/**
+	@relates entity_s
+	@fn void entity_t__setDirty(Entity_t *self, uint8_t dirty)
+	@brief Set whether the entity waits in the dirty set of its spatial index
+	@param self Object pointer
+	@param dirty Boolean TRUE while the entity is marked
+	@return void
+	
+	@note Only the index clears it, once the entity left its dirty set
+*/
+void entity_t__setDirty(Entity_t *self, uint8_t dirty)
+{
+	self->entity.node.dirty = dirty;
+}
+
+/**
+	@relates entity_s
+	@fn void entity_t__setMark(Entity_t *self, size_t mark)
+	@brief Set the slot of the entity in the dirty set of its spatial index
+	@param self Object pointer
+	@param mark Dirty set slot
+	@return void
+	
+	@note Only meaningful while the entity is dirty
+*/
+void entity_t__setMark(Entity_t *self, size_t mark)
+{
+	self->entity.node.mark = mark;
+}
+
+/**
+	@relates entity_s
+	@fn void entity_t__setContacts(Entity_t *self, size_t run, Entity_t **other, size_t count)
+	@brief Set entity contacts found by a broad phase, update tests them instead of querying its space
+	@param self Object pointer
+	@param run Sweep run that saw the entity, its contacts hold until the next run
+	@param other Contacts array, NULL to query the space again
+	@param count Contacts count
+	@return void
+*/
+void entity_t__setContacts(Entity_t *self, size_t run, Entity_t **other, size_t count)
+{
+	self->entity.contact.other = other;
+	self->entity.contact.count = count;
+	self->entity.contact.run = run;
 }
 
 /**
@@ -317,7 +538,7 @@ SDL_FPoint entity_t__getPosition(Entity_t *self)
 /**
 	@relates entity_s
 	@fn void entity_t__setDeltaPosition(Entity_t *self, float dx, float dy)
-	@brief Set entity delta position
+	@brief Set entity delta position, marking the entity dirty in its spatial index
 	@param self Object pointer
 	@param dx Delta x position
 	@param dy Delta y position
@@ -325,6 +546,20 @@ SDL_FPoint entity_t__getPosition(Entity_t *self)
 */
 void entity_t__setDeltaPosition(Entity_t *self, float dx, float dy)
 {
+	Space_t *space = NULL;
+	
+	if (!dx && !dy)
+		return;
+	
+	space = self->entity.vtable->getSpace(self);
+	
+	if (space && !self->entity.node.dirty)
+	{
+		self->entity.node.dirty = 1;
+		self->entity.node.from = self->entity.vtable->getPosition(self);
+		space->space.vtable->mark(space, self);
+	}
+	
 	self->entity.position.x += dx;
 	self->entity.position.y += dy;
 }
@@ -365,11 +600,31 @@ SDL_FRect entity_t__getTextureRect(Entity_t *self)
 	@fn SDL_Texture *entity_t__getTexture(Entity_t *self)
 	@brief Get entity texture
 	@param self Object pointer
-	@return Entity texture
+	@return Entity texture, NULL when its image failed to load
 */
 SDL_Texture *entity_t__getTexture(Entity_t *self)
 {
-	return self->entity.graphics.texture;
+	if (!self->entity.graphics.texture)
+		return NULL;
+	
+	return self->entity.graphics.texture->texture;
+}
+
+/**
+	@relates entity_s
+	@fn SDL_Rect entity_t__getTextureClip(Entity_t *self)
+	@brief Get entity texture clip inside the atlas texture
+	@param self Object pointer
+	@return Entity texture clip
+*/
+SDL_Rect entity_t__getTextureClip(Entity_t *self)
+{
+	SDL_Rect rect = { 0, 0, 0, 0 };
+	
+	if (self->entity.graphics.texture)
+		rect = self->entity.graphics.texture->rect;
+	
+	return rect;
 }
 
 /**
@@ -415,7 +670,7 @@ void entity_t__setLighting(Entity_t *self, float radius, SDL_Color color)
 	SDL_PixelFormat	*format = NULL;
 
 	self->entity.graphics.radius = radius;
-	rect = self->entity.getTextureRect(self);
+	rect = self->entity.vtable->getTextureRect(self);
 	width = rect.w * radius;
 	height = rect.h * radius;
 	lenght = MIN(rect.w, rect.h) * radius / 2;
@@ -475,7 +730,7 @@ SDL_FRect entity_t__getLightingRect(Entity_t *self)
 {
 	SDL_FRect rect;
 
-	rect = self->entity.getTextureRect(self);
+	rect = self->entity.vtable->getTextureRect(self);
 	rect.x -= rect.w * (self->entity.graphics.radius - 1) / 2;
 	rect.y -= rect.h * (self->entity.graphics.radius - 1) / 2;
 	rect.w *= self->entity.graphics.radius;
@@ -484,49 +739,54 @@ SDL_FRect entity_t__getLightingRect(Entity_t *self)
 	return rect;
 }
 
+static const entity_vtable_t entity_vtable = {
+	&entity_t__draw,
+	&entity_t__setSpace,
+	&entity_t__setNode,
+	&entity_t__setDirty,
+	&entity_t__setMark,
+	&entity_t__setContacts,
+	&entity_t__setDeltaPosition,
+	&entity_t__setLighting,
+	&entity_t__transition,
+	&entity_t__update,
+	&entity_t__states,
+	&entity_t__getLayer,
+	&entity_t__getSpace,
+	&entity_t__getNode,
+	&entity_t__getTextureClip,
+	&entity_t__getHitbox,
+	&entity_t__getTextureRect,
+	&entity_t__getLightingRect,
+	&entity_t__getPosition,
+	&entity_t__getTexture,
+	&entity_t__getLighting
+};
+
 retno_t entity_t__ctor(Entity_t *self)
 {
-	int retno;
-	int width;
-	int height;
+	Window_t *window = NULL;
 	
-	self->entity.graphics.texture = IMG_LoadTexture(
-		self->entity.window->window.renderer,
+	window = self->entity.window;
+	self->entity.graphics.texture = window->window.vtable->takeTexture(
+		window,
 		self->entity.graphics.path
 	);
-	LOG_ERROR(!self->entity.graphics.texture, SDL_GetError());
 	
-	retno = SDL_QueryTexture(
-		self->entity.graphics.texture,
-		NULL, NULL,
-		&width,
-		&height
-	);
-	LOG_ERROR(retno, SDL_GetError());
-	self->entity.graphics.width = width;
-	self->entity.graphics.height = height;
+	if (self->entity.graphics.texture)
+	{
+		self->entity.graphics.width = self->entity.graphics.texture->width;
+		self->entity.graphics.height = self->entity.graphics.texture->height;
+	}
 	
 	self->entity.delta.s = 1.0;
 	
-	self->entity.state = calloc(1, sizeof(entity_state_t));
+	/* The first state lives in the entity so spawning one does not allocate */
+	self->entity.state = &(self->entity.origin);
 	self->entity.state->id = 0;
 	self->entity.state->transition = CList();
 	
-	self->entity.draw				= &entity_t__draw;
-	self->entity.states			  = &entity_t__states;
-	self->entity.update			  = &entity_t__update;
-	self->entity.getQTree			= entity_t__getQTree;
-	self->entity.setQTree			= entity_t__setQTree;
-	self->entity.getLayer			= entity_t__getLayer;
-	self->entity.getHitbox		   = &entity_t__getHitbox;
-	self->entity.getTexture		  = &entity_t__getTexture;
-	self->entity.transition		  = &entity_t__transition;
-	self->entity.setLighting		 = &entity_t__setLighting;
-	self->entity.getLighting		 = &entity_t__getLighting;
-	self->entity.getPosition		 = &entity_t__getPosition;
-	self->entity.getTextureRect	  = &entity_t__getTextureRect;
-	self->entity.getLightingRect	 = &entity_t__getLightingRect;
-	self->entity.setDeltaPosition	= &entity_t__setDeltaPosition;
+	self->entity.vtable = &entity_vtable;
 	
 	
 	return SUCCESS;
@@ -539,35 +799,44 @@ retno_t entity_t__dtor(Entity_t *self)
 	entity_state_t		 *elem = NULL;
 	entity_transition_t	*transition = NULL;
 	
+	/* The last sweep run may hold the entity in the contacts of its movers */
+	if (self->entity.contact.run && self->entity.contact.run == sweep_t__clock())
+		sweep_t__expire();
+	
 	if (self->entity.graphics.texture)
-		SDL_DestroyTexture(self->entity.graphics.texture);
+		self->entity.window->window.vtable->releaseTexture(
+			self->entity.window,
+			self->entity.graphics.texture
+		);
 
 	if (self->entity.graphics.shadow)
 		SDL_DestroyTexture(self->entity.graphics.shadow);
 	
 	if (self->entity.state)
 	{
-		states = self->entity.states(self);
-		elem = states->clist.iter(states, &block);
+		states = self->entity.vtable->states(self);
+		elem = states->clist.vtable->iter(states, &block);
 		
 		while (elem)
 		{
-			transition = elem->transition->clist.pop(elem->transition);
+			transition = elem->transition->clist.vtable->pop(elem->transition);
 			while (transition)
 			{
 				free(transition);
-				transition = elem->transition->clist.pop(elem->transition);
+				transition = elem->transition->clist.vtable->pop(elem->transition);
 			}
 			
 			delete(elem->transition);
-			elem = states->clist.iter(states, &block);
+			elem = states->clist.vtable->iter(states, &block);
 		}
 		
-		elem = states->clist.pop(states);
+		elem = states->clist.vtable->pop(states);
 		while (elem)
 		{
-			free(elem);
-			elem = states->clist.pop(states);
+			if (elem != &(self->entity.origin))
+				free(elem);
+			
+			elem = states->clist.vtable->pop(states);
 		}
 		
 		delete(states);
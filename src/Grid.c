@@ -0,0 +1,476 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Grid.c
+*/
+
+#include <Base.h>
+#include <Entity.h>
+#include <math.h>
+#include <SDL2/SDL.h>
+#include <Space.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <Window.h>
+
+/**
+	@relates grid_s
+	@fn grid_bucket_t *grid_t__bucket(Grid_t *self, int32_t x, int32_t y)
+	@brief Get the bucket a cell hashes to
+	@param self Object pointer
+	@param x Cell x
+	@param y Cell y
+	@return Bucket pointer
+*/
+grid_bucket_t *grid_t__bucket(Grid_t *self, int32_t x, int32_t y)
+{
+	uint32_t hash;
+	
+	hash = (uint32_t) x + (uint32_t) y * 2654435761u;
+	
+	return &(self->grid.bucket[hash & (self->grid.buckets - 1)]);
+}
+
+/**
+	@relates grid_s
+	@fn int32_t grid_t__cell(Grid_t *self, float value)
+	@brief Get the cell of a coordinate
+	@param self Object pointer
+	@param value Coordinate
+	@return Cell coordinate
+*/
+int32_t grid_t__cell(Grid_t *self, float value)
+{
+	return (int32_t) floor(value / self->grid.cell);
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__place(Grid_t *self, size_t index)
+	@brief Put an item in the bucket of its hitbox center cell
+	@param self Object pointer
+	@param index Item index
+	@return void
+*/
+void grid_t__place(Grid_t *self, size_t index)
+{
+	SDL_FRect		rect;
+	grid_item_t	  *item = NULL;
+	grid_bucket_t	*bucket = NULL;
+	
+	item = &(self->grid.item[index]);
+	rect = item->content->entity.vtable->getHitbox(item->content);
+	item->x = grid_t__cell(self, rect.x + rect.w / 2);
+	item->y = grid_t__cell(self, rect.y + rect.h / 2);
+	bucket = grid_t__bucket(self, item->x, item->y);
+	
+	if (bucket->count == bucket->size)
+	{
+		bucket->size = bucket->size ? bucket->size * 2 : GRID_LOAD;
+		bucket->item = realloc(bucket->item, bucket->size * sizeof(size_t));
+	}
+	
+	item->slot = bucket->count;
+	bucket->item[bucket->count++] = index;
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__lift(Grid_t *self, size_t index)
+	@brief Take an item out of its bucket, the last item of the bucket takes its slot
+	@param self Object pointer
+	@param index Item index
+	@return void
+*/
+void grid_t__lift(Grid_t *self, size_t index)
+{
+	grid_item_t	  *item = NULL;
+	grid_bucket_t	*bucket = NULL;
+	
+	item = &(self->grid.item[index]);
+	bucket = grid_t__bucket(self, item->x, item->y);
+	bucket->item[item->slot] = bucket->item[--bucket->count];
+	
+	if (item->slot < bucket->count)
+		self->grid.item[bucket->item[item->slot]].slot = item->slot;
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__rehash(Grid_t *self)
+	@brief Double the buckets count and spread the items again
+	@param self Object pointer
+	@return void
+*/
+void grid_t__rehash(Grid_t *self)
+{
+	size_t			i;
+	grid_bucket_t	 *bucket = NULL;
+	
+	for (i = 0; i < self->grid.buckets; ++i)
+		free(self->grid.bucket[i].item);
+	
+	free(self->grid.bucket);
+	self->grid.buckets *= 2;
+	self->grid.bucket = calloc(self->grid.buckets, sizeof(grid_bucket_t));
+	
+	for (i = 0; i < self->grid.count; ++i)
+	{
+		bucket = grid_t__bucket(self, self->grid.item[i].x, self->grid.item[i].y);
+		
+		if (bucket->count == bucket->size)
+		{
+			bucket->size = bucket->size ? bucket->size * 2 : GRID_LOAD;
+			bucket->item = realloc(bucket->item, bucket->size * sizeof(size_t));
+		}
+		
+		self->grid.item[i].slot = bucket->count;
+		bucket->item[bucket->count++] = i;
+	}
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__insert(Grid_t *self, Entity_t *content)
+	@brief Insert element in the cell of its hitbox center
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+	
+	@note The buckets double past GRID_LOAD items per bucket
+*/
+void grid_t__insert(Grid_t *self, Entity_t *content)
+{
+	SDL_FRect rect;
+	
+	if (!content->entity.vtable->getSpace(content))
+		content->entity.vtable->setSpace(content, self);
+	
+	if (self->grid.count == self->grid.size)
+	{
+		self->grid.size *= 2;
+		self->grid.item = realloc(self->grid.item, self->grid.size * sizeof(grid_item_t));
+	}
+	
+	if (self->grid.count >= self->grid.buckets * GRID_LOAD)
+		grid_t__rehash(self);
+	
+	rect = content->entity.vtable->getHitbox(content);
+	self->grid.item[self->grid.count].content = content;
+	grid_t__place(self, self->grid.count);
+	content->entity.vtable->setNode(content, self, self->grid.count);
+	self->grid.count++;
+	self->grid.layer |= content->entity.vtable->getLayer(content);
+	self->grid.margin.x = MAX(self->grid.margin.x, rect.w / 2);
+	self->grid.margin.y = MAX(self->grid.margin.y, rect.h / 2);
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__build(Grid_t *self, Entity_t **content, size_t count)
+	@brief Insert an elements array at once
+	@param self Object pointer
+	@param content Elements array
+	@param count Elements count
+	@return void
+*/
+void grid_t__build(Grid_t *self, Entity_t **content, size_t count)
+{
+	size_t i;
+	
+	for (i = 0; i < count; ++i)
+		self->grid.vtable->insert(self, content[i]);
+}
+
+/**
+	@relates grid_s
+	@fn uint8_t grid_t__remove(Grid_t *self, Entity_t *content)
+	@brief Remove element in constant time
+	@param self Object pointer
+	@param content Element pointer
+	@return Boolean TRUE if the element was in the grid
+*/
+uint8_t grid_t__remove(Grid_t *self, Entity_t *content)
+{
+	size_t			last;
+	Entity_t		  *elem = NULL;
+	grid_item_t	   *item = NULL;
+	entity_node_t	 node;
+	
+	node = content->entity.vtable->getNode(content);
+	
+	if (node.leaf != self || node.slot >= self->grid.count ||
+		self->grid.item[node.slot].content != content)
+		return 0;
+	
+	if (node.dirty)
+	{
+		elem = self->grid.dirty[--self->grid.marked];
+		self->grid.dirty[node.mark] = elem;
+		elem->entity.vtable->setMark(elem, node.mark);
+		content->entity.vtable->setDirty(content, 0);
+	}
+	
+	grid_t__lift(self, node.slot);
+	last = --self->grid.count;
+	
+	if (node.slot < last)
+	{
+		item = &(self->grid.item[node.slot]);
+		*item = self->grid.item[last];
+		grid_t__bucket(self, item->x, item->y)->item[item->slot] = node.slot;
+		elem = item->content;
+		elem->entity.vtable->setNode(elem, self, node.slot);
+	}
+	
+	content->entity.vtable->setNode(content, NULL, 0);
+	content->entity.vtable->setSpace(content, NULL);
+	
+	return 1;
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__mark(Grid_t *self, Entity_t *content)
+	@brief Record a moved element, it changes of cell on the next update
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+*/
+void grid_t__mark(Grid_t *self, Entity_t *content)
+{
+	if (self->grid.marked == self->grid.reserved)
+	{
+		self->grid.reserved = self->grid.reserved ? self->grid.reserved * 2 : GRID_SIZE;
+		self->grid.dirty = realloc(self->grid.dirty, self->grid.reserved * sizeof(Entity_t *));
+	}
+	
+	content->entity.vtable->setMark(content, self->grid.marked);
+	self->grid.dirty[self->grid.marked++] = content;
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__update(Grid_t *self)
+	@brief Move the dirty elements to the bucket of their new cell
+	@param self Object pointer
+	@return void
+	
+	@note Only elements moved through setDeltaPosition are seen by update
+*/
+void grid_t__update(Grid_t *self)
+{
+	size_t			i;
+	int32_t		   x, y;
+	Entity_t		  *elem = NULL;
+	SDL_FRect		 rect;
+	grid_item_t	   *item = NULL;
+	entity_node_t	 node;
+	
+	for (i = 0; i < self->grid.marked; ++i)
+	{
+		elem = self->grid.dirty[i];
+		node = elem->entity.vtable->getNode(elem);
+		item = &(self->grid.item[node.slot]);
+		rect = elem->entity.vtable->getHitbox(elem);
+		x = grid_t__cell(self, rect.x + rect.w / 2);
+		y = grid_t__cell(self, rect.y + rect.h / 2);
+		
+		if (x != item->x || y != item->y)
+		{
+			grid_t__lift(self, node.slot);
+			grid_t__place(self, node.slot);
+		}
+		
+		elem->entity.vtable->setDirty(elem, 0);
+	}
+	
+	self->grid.marked = 0;
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__scan(Grid_t *self, grid_bucket_t *bucket, SDL_FRect rect, layer_t layer, SDL_Rect cells, space_visit_t callback, void *data)
+	@brief Call back the elements of a bucket in rect area whose cell is in a cells range
+	@param self Object pointer
+	@param bucket Bucket pointer
+	@param rect Area
+	@param layer Layers mask
+	@param cells Cells range, other cells sharing the bucket are skipped
+	@param callback Function called with each element and data
+	@param data User pointer given to callback
+	@return void
+*/
+void grid_t__scan(Grid_t *self, grid_bucket_t *bucket, SDL_FRect rect, layer_t layer, SDL_Rect cells, space_visit_t callback, void *data)
+{
+	size_t		 i;
+	Entity_t	   *elem = NULL;
+	SDL_FRect	  subrect;
+	grid_item_t	*item = NULL;
+	
+	for (i = 0; i < bucket->count; ++i)
+	{
+		item = &(self->grid.item[bucket->item[i]]);
+		
+		if (item->x < cells.x || item->x >= cells.x + cells.w ||
+			item->y < cells.y || item->y >= cells.y + cells.h)
+			continue;
+		
+		elem = item->content;
+		subrect = elem->entity.vtable->getHitbox(elem);
+		
+		if (elem->entity.vtable->getLayer(elem) & layer &&
+			SDL_HasIntersectionF(&subrect, &rect))
+			callback(elem, data);
+	}
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__visit(Grid_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data)
+	@brief Call back every element of the layers in rect area without allocating
+	@param self Object pointer
+	@param rect Area
+	@param layer Layers mask
+	@param callback Function called with each element and data
+	@param data User pointer given to callback
+	@return void
+	
+	@note The area grows by the largest hitbox half size, areas over more cells than buckets
+	scan every bucket once
+*/
+void grid_t__visit(Grid_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data)
+{
+	size_t		i;
+	int32_t	   x, y;
+	SDL_Rect	  cells;
+	SDL_Rect	  cell;
+	
+	if (!self->grid.count || !(self->grid.layer & layer))
+		return;
+	
+	cells.x = grid_t__cell(self, rect.x - self->grid.margin.x);
+	cells.y = grid_t__cell(self, rect.y - self->grid.margin.y);
+	cells.w = grid_t__cell(self, rect.x + rect.w + self->grid.margin.x) - cells.x + 1;
+	cells.h = grid_t__cell(self, rect.y + rect.h + self->grid.margin.y) - cells.y + 1;
+	
+	if ((size_t) cells.w * (size_t) cells.h > self->grid.buckets)
+	{
+		for (i = 0; i < self->grid.buckets; ++i)
+			grid_t__scan(self, &(self->grid.bucket[i]), rect, layer, cells, callback, data);
+		
+		return;
+	}
+	
+	cell.w = 1;
+	cell.h = 1;
+	
+	for (y = cells.y; y < cells.y + cells.h; ++y)
+	{
+		for (x = cells.x; x < cells.x + cells.w; ++x)
+		{
+			cell.x = x;
+			cell.y = y;
+			grid_t__scan(self, grid_t__bucket(self, x, y), rect, layer, cell, callback, data);
+		}
+	}
+}
+
+/**
+	@relates grid_s
+	@fn void grid_t__draw(Grid_t *self, Window_t *window)
+	@brief Draw grid populated cells
+	@param self Object pointer
+	@param window Window pointer
+	@return void
+	
+	@warning Use it only for debugging
+*/
+void grid_t__draw(Grid_t *self, Window_t *window)
+{
+	size_t		i;
+	SDL_FRect	 rect;
+	
+	rect.w = self->grid.cell;
+	rect.h = self->grid.cell;
+	
+	for (i = 0; i < self->grid.count; ++i)
+	{
+		rect.x = self->grid.item[i].x * self->grid.cell;
+		rect.y = self->grid.item[i].y * self->grid.cell;
+		window->window.vtable->putRect(window, rect);
+	}
+}
+
+static const space_vtable_t grid_vtable = {
+	&grid_t__update,
+	&grid_t__draw,
+	&grid_t__insert,
+	&grid_t__build,
+	&grid_t__mark,
+	&grid_t__visit,
+	&space_t__fetch,
+	&space_t__fetchLayer,
+	&space_t__query,
+	&space_t__fetchVector,
+	&space_t__fetchFrame,
+	&grid_t__remove,
+	&space_t__move,
+	&space_t__visitCircle,
+	&space_t__nearest,
+	&space_t__raycast
+};
+
+retno_t grid_t__ctor(Grid_t *self)
+{
+	size_t buckets = 1;
+	
+	/* Buckets are masked out of the hash, their count is rounded up to a power of 2 */
+	while (buckets < self->grid.buckets)
+		buckets *= 2;
+	
+	self->grid.loose = 1;
+	self->grid.layer = NO_LAYER;
+	self->grid.buckets = buckets;
+	self->grid.bucket = calloc(self->grid.buckets, sizeof(grid_bucket_t));
+	self->grid.size = GRID_SIZE;
+	self->grid.item = malloc(self->grid.size * sizeof(grid_item_t));
+	
+	self->grid.vtable = &grid_vtable;
+	
+	return SUCCESS;
+}
+
+retno_t grid_t__dtor(Grid_t *self)
+{
+	size_t i;
+	
+	for (i = 0; i < self->grid.count; ++i)
+		delete(self->grid.item[i].content);
+	
+	for (i = 0; i < self->grid.buckets; ++i)
+		free(self->grid.bucket[i].item);
+	
+	free(self->grid.bucket);
+	free(self->grid.item);
+	free(self->grid.dirty);
+	
+	return SUCCESS;
+}
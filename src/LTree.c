@@ -0,0 +1,503 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file LTree.c
+*/
+
+#include <Base.h>
+#include <Entity.h>
+#include <SDL2/SDL.h>
+#include <Space.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Window.h>
+
+/**
+	@relates ltree_s
+	@fn uint32_t ltree_t__spread(uint32_t value)
+	@brief Spread the low bits of a value on the even bits
+	@param value Value on LTREE_BITS bits
+	@return Spread value
+*/
+uint32_t ltree_t__spread(uint32_t value)
+{
+	value &= 0x0000FFFF;
+	value = (value | (value << 8)) & 0x00FF00FF;
+	value = (value | (value << 4)) & 0x0F0F0F0F;
+	value = (value | (value << 2)) & 0x33333333;
+	value = (value | (value << 1)) & 0x55555555;
+	
+	return value;
+}
+
+/**
+	@relates ltree_s
+	@fn uint32_t ltree_t__quantize(float value, float origin, float extent)
+	@brief Map a coordinate on the LTREE_BITS grid of an axis, clamping out of the area
+	@param value Coordinate
+	@param origin Area origin on the axis
+	@param extent Area extent on the axis
+	@return Grid coordinate
+*/
+uint32_t ltree_t__quantize(float value, float origin, float extent)
+{
+	float grid;
+	
+	grid = (value - origin) / extent * (1 << LTREE_BITS);
+	
+	if (!(grid > 0))
+		return 0;
+	
+	if (grid >= (1 << LTREE_BITS) - 1)
+		return (1 << LTREE_BITS) - 1;
+	
+	return (uint32_t) grid;
+}
+
+/**
+	@relates ltree_s
+	@fn uint32_t ltree_t__code(LTree_t *self, Entity_t *content)
+	@brief Get the Morton code of an element hitbox center
+	@param self Object pointer
+	@param content Element pointer
+	@return Morton code
+*/
+uint32_t ltree_t__code(LTree_t *self, Entity_t *content)
+{
+	SDL_FRect rect;
+	
+	rect = content->entity.vtable->getHitbox(content);
+	
+	return ltree_t__spread(ltree_t__quantize(rect.x + rect.w / 2, self->ltree.rect.x, self->ltree.rect.w)) |
+		ltree_t__spread(ltree_t__quantize(rect.y + rect.h / 2, self->ltree.rect.y, self->ltree.rect.h)) << 1;
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__sort(LTree_t *self)
+	@brief Sort the cells by Morton code with a byte wise radix sort
+	@param self Object pointer
+	@return void
+	
+	@note Passes where every cell shares the same byte are skipped
+*/
+void ltree_t__sort(LTree_t *self)
+{
+	size_t		  i;
+	size_t		  shift;
+	size_t		  count[256];
+	size_t		  offset;
+	size_t		  total;
+	ltree_cell_t	*swap = NULL;
+	
+	for (shift = 0; shift < 32; shift += 8)
+	{
+		memset(count, 0, sizeof(count));
+		
+		for (i = 0; i < self->ltree.count; ++i)
+			count[(self->ltree.cell[i].code >> shift) & 0xFF]++;
+		
+		if (count[(self->ltree.cell[0].code >> shift) & 0xFF] == self->ltree.count)
+			continue;
+		
+		for (i = 0, offset = 0; i < 256; ++i)
+		{
+			total = count[i];
+			count[i] = offset;
+			offset += total;
+		}
+		
+		for (i = 0; i < self->ltree.count; ++i)
+			self->ltree.swap[count[(self->ltree.cell[i].code >> shift) & 0xFF]++] = self->ltree.cell[i];
+		
+		swap = self->ltree.cell;
+		self->ltree.cell = self->ltree.swap;
+		self->ltree.swap = swap;
+	}
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__rebuild(LTree_t *self)
+	@brief Drop removed cells, code every element again and sort them
+	@param self Object pointer
+	@return void
+*/
+void ltree_t__rebuild(LTree_t *self)
+{
+	size_t		i;
+	size_t		count = 0;
+	Entity_t	  *elem = NULL;
+	SDL_FRect	 rect;
+	
+	self->ltree.layer = NO_LAYER;
+	self->ltree.margin.x = 0;
+	self->ltree.margin.y = 0;
+	
+	for (i = 0; i < self->ltree.count; ++i)
+	{
+		elem = self->ltree.cell[i].content;
+		
+		if (elem)
+		{
+			rect = elem->entity.vtable->getHitbox(elem);
+			self->ltree.cell[count].content = elem;
+			self->ltree.cell[count++].code = ltree_t__code(self, elem);
+			self->ltree.layer |= elem->entity.vtable->getLayer(elem);
+			self->ltree.margin.x = MAX(self->ltree.margin.x, rect.w / 2);
+			self->ltree.margin.y = MAX(self->ltree.margin.y, rect.h / 2);
+		}
+	}
+	
+	self->ltree.count = count;
+	
+	if (count)
+		ltree_t__sort(self);
+	
+	for (i = 0; i < count; ++i)
+	{
+		elem = self->ltree.cell[i].content;
+		elem->entity.vtable->setNode(elem, self, i);
+		elem->entity.vtable->setDirty(elem, 0);
+	}
+	
+	self->ltree.holes = 0;
+	self->ltree.moved = 0;
+	self->ltree.sorted = 1;
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__scan(LTree_t *self, ltree_query_t *query)
+	@brief Call back the elements of a query pending code range, found by binary search
+	@param self Object pointer
+	@param query Query pointer
+	@return void
+*/
+void ltree_t__scan(LTree_t *self, ltree_query_t *query)
+{
+	size_t		i;
+	size_t		low = 0;
+	size_t		high;
+	Entity_t	  *elem = NULL;
+	SDL_FRect	 rect;
+	
+	high = self->ltree.count;
+	
+	while (low < high)
+	{
+		i = low + (high - low) / 2;
+		
+		if (self->ltree.cell[i].code < query->from)
+			low = i + 1;
+		else
+			high = i;
+	}
+	
+	for (i = low; i < self->ltree.count && self->ltree.cell[i].code <= query->to; ++i)
+	{
+		elem = self->ltree.cell[i].content;
+		
+		if (!elem || !(elem->entity.vtable->getLayer(elem) & query->layer))
+			continue;
+		
+		rect = elem->entity.vtable->getHitbox(elem);
+		
+		if (SDL_HasIntersectionF(&rect, &(query->rect)))
+			query->callback(elem, query->data);
+	}
+	
+	query->pending = 0;
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__range(LTree_t *self, ltree_query_t *query, uint32_t x, uint32_t y, size_t level)
+	@brief Split the query area along the Morton cells, adjacent code ranges are merged into one scan
+	@param self Object pointer
+	@param query Query pointer
+	@param x Cell grid x
+	@param y Cell grid y
+	@param level Cell size as a power of 2
+	@return void
+*/
+void ltree_t__range(LTree_t *self, ltree_query_t *query, uint32_t x, uint32_t y, size_t level)
+{
+	uint32_t	size;
+	uint32_t	from;
+	uint32_t	to;
+	
+	size = (uint32_t) 1 << level;
+	
+	if (x > query->max[0] || x + (size - 1) < query->min[0] ||
+		y > query->max[1] || y + (size - 1) < query->min[1])
+		return;
+	
+	if (level + LTREE_DEPTH > LTREE_BITS &&
+		(x < query->min[0] || x + (size - 1) > query->max[0] ||
+		y < query->min[1] || y + (size - 1) > query->max[1]))
+	{
+		level--;
+		size /= 2;
+		ltree_t__range(self, query, x, y, level);
+		ltree_t__range(self, query, x + size, y, level);
+		ltree_t__range(self, query, x, y + size, level);
+		ltree_t__range(self, query, x + size, y + size, level);
+		return;
+	}
+	
+	from = ltree_t__spread(x) | ltree_t__spread(y) << 1;
+	to = from | (level < LTREE_BITS ? ((uint32_t) 1 << (2 * level)) - 1 : 0xFFFFFFFF);
+	
+	if (query->pending && from == query->to + 1)
+	{
+		query->to = to;
+		return;
+	}
+	
+	if (query->pending)
+		ltree_t__scan(self, query);
+	
+	query->from = from;
+	query->to = to;
+	query->pending = 1;
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__visit(LTree_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data)
+	@brief Call back every element of the layers in rect area without allocating
+	@param self Object pointer
+	@param rect Area
+	@param layer Layers mask
+	@param callback Function called with each element and data
+	@param data User pointer given to callback
+	@return void
+	
+	@note The area grows by the largest hitbox half size, then each Morton range is scanned in order
+	@warning Pending inserts are sorted first, the visit only leaves the tree untouched after an update
+*/
+void ltree_t__visit(LTree_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data)
+{
+	ltree_query_t query;
+	
+	if (!self->ltree.sorted)
+		ltree_t__rebuild(self);
+	
+	if (!self->ltree.count || !(self->ltree.layer & layer))
+		return;
+	
+	query.rect = rect;
+	query.layer = layer;
+	query.callback = callback;
+	query.data = data;
+	query.pending = 0;
+	query.min[0] = ltree_t__quantize(rect.x - self->ltree.margin.x, self->ltree.rect.x, self->ltree.rect.w);
+	query.min[1] = ltree_t__quantize(rect.y - self->ltree.margin.y, self->ltree.rect.y, self->ltree.rect.h);
+	query.max[0] = ltree_t__quantize(rect.x + rect.w + self->ltree.margin.x, self->ltree.rect.x, self->ltree.rect.w);
+	query.max[1] = ltree_t__quantize(rect.y + rect.h + self->ltree.margin.y, self->ltree.rect.y, self->ltree.rect.h);
+	
+	ltree_t__range(self, &query, 0, 0, LTREE_BITS);
+	
+	if (query.pending)
+		ltree_t__scan(self, &query);
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__insert(LTree_t *self, Entity_t *content)
+	@brief Insert element, the cells are sorted again on the next update or query
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+	
+	@note Elements coming in Morton order keep the cells sorted
+*/
+void ltree_t__insert(LTree_t *self, Entity_t *content)
+{
+	uint32_t	code;
+	SDL_FRect   rect;
+	
+	if (!content->entity.vtable->getSpace(content))
+		content->entity.vtable->setSpace(content, self);
+	
+	if (self->ltree.count == self->ltree.size)
+	{
+		self->ltree.size *= 2;
+		self->ltree.cell = realloc(self->ltree.cell, self->ltree.size * sizeof(ltree_cell_t));
+		self->ltree.swap = realloc(self->ltree.swap, self->ltree.size * sizeof(ltree_cell_t));
+	}
+	
+	code = ltree_t__code(self, content);
+	rect = content->entity.vtable->getHitbox(content);
+	
+	if (self->ltree.count && code < self->ltree.cell[self->ltree.count - 1].code)
+		self->ltree.sorted = 0;
+	
+	self->ltree.cell[self->ltree.count].code = code;
+	self->ltree.cell[self->ltree.count].content = content;
+	content->entity.vtable->setNode(content, self, self->ltree.count);
+	self->ltree.count++;
+	self->ltree.layer |= content->entity.vtable->getLayer(content);
+	self->ltree.margin.x = MAX(self->ltree.margin.x, rect.w / 2);
+	self->ltree.margin.y = MAX(self->ltree.margin.y, rect.h / 2);
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__build(LTree_t *self, Entity_t **content, size_t count)
+	@brief Insert an elements array at once, sorted with a single radix sort
+	@param self Object pointer
+	@param content Elements array
+	@param count Elements count
+	@return void
+*/
+void ltree_t__build(LTree_t *self, Entity_t **content, size_t count)
+{
+	size_t i;
+	
+	for (i = 0; i < count; ++i)
+		self->ltree.vtable->insert(self, content[i]);
+	
+	if (!self->ltree.sorted)
+		ltree_t__rebuild(self);
+}
+
+/**
+	@relates ltree_s
+	@fn uint8_t ltree_t__remove(LTree_t *self, Entity_t *content)
+	@brief Remove element in constant time, its cell is dropped on the next rebuild
+	@param self Object pointer
+	@param content Element pointer
+	@return Boolean TRUE if the element was in the tree
+*/
+uint8_t ltree_t__remove(LTree_t *self, Entity_t *content)
+{
+	entity_node_t node;
+	
+	node = content->entity.vtable->getNode(content);
+	
+	if (node.leaf != self || node.slot >= self->ltree.count ||
+		self->ltree.cell[node.slot].content != content)
+		return 0;
+	
+	self->ltree.cell[node.slot].content = NULL;
+	self->ltree.holes++;
+	content->entity.vtable->setNode(content, NULL, 0);
+	content->entity.vtable->setDirty(content, 0);
+	content->entity.vtable->setSpace(content, NULL);
+	
+	return 1;
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__mark(LTree_t *self, Entity_t *content)
+	@brief Record that an element moved, the tree is rebuilt on the next update
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+*/
+void ltree_t__mark(LTree_t *self, Entity_t *content)
+{
+	self->ltree.moved = 1;
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__update(LTree_t *self)
+	@brief Rebuild the tree when elements moved or were inserted
+	@param self Object pointer
+	@return void
+	
+	@note Only elements moved through setDeltaPosition are seen by update.
+	Removed cells are dropped once they are half of the tree.
+*/
+void ltree_t__update(LTree_t *self)
+{
+	if (self->ltree.moved || !self->ltree.sorted ||
+		self->ltree.holes * 2 > self->ltree.count)
+		ltree_t__rebuild(self);
+}
+
+/**
+	@relates ltree_s
+	@fn void ltree_t__draw(LTree_t *self, Window_t *window)
+	@brief Draw linear quadtree area
+	@param self Object pointer
+	@param window Window pointer
+	@return void
+	
+	@warning Use it only for debugging
+*/
+void ltree_t__draw(LTree_t *self, Window_t *window)
+{
+	window->window.vtable->putRect(window, self->ltree.rect);
+}
+
+static const space_vtable_t ltree_vtable = {
+	&ltree_t__update,
+	&ltree_t__draw,
+	&ltree_t__insert,
+	&ltree_t__build,
+	&ltree_t__mark,
+	&ltree_t__visit,
+	&space_t__fetch,
+	&space_t__fetchLayer,
+	&space_t__query,
+	&space_t__fetchVector,
+	&space_t__fetchFrame,
+	&ltree_t__remove,
+	&space_t__move,
+	&space_t__visitCircle,
+	&space_t__nearest,
+	&space_t__raycast
+};
+
+retno_t ltree_t__ctor(LTree_t *self)
+{
+	self->ltree.loose = 1;
+	self->ltree.layer = NO_LAYER;
+	self->ltree.sorted = 1;
+	self->ltree.size = LTREE_SIZE;
+	self->ltree.cell = malloc(self->ltree.size * sizeof(ltree_cell_t));
+	self->ltree.swap = malloc(self->ltree.size * sizeof(ltree_cell_t));
+	
+	self->ltree.vtable = &ltree_vtable;
+	
+	return SUCCESS;
+}
+
+retno_t ltree_t__dtor(LTree_t *self)
+{
+	size_t i;
+	
+	for (i = 0; i < self->ltree.count; ++i)
+	{
+		if (self->ltree.cell[i].content)
+			delete(self->ltree.cell[i].content);
+	}
+	
+	free(self->ltree.cell);
+	free(self->ltree.swap);
+	
+	return SUCCESS;
+}
@@ -21,267 +21,1291 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
 #include <Base.h>
-#include <CList.h>
+#include <Batch.h>
 #include <Entity.h>
-#include <QTree.h>
 #include <SDL2/SDL.h>
+#include <Space.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <Window.h>
 
+struct qtree_slab {
+	qtree_slab_t *next;
+	QTree_t node[QTREE_SLAB];
+};
+
+/**
+	@relates qtree_s
+	@fn QTree_t *qtree_t__alloc(QTree_t *self, SDL_FRect rect)
+	@brief Take a node from the tree pool, a new slab is allocated when the pool is empty
+	@param self Object pointer
+	@param rect Node area
+	@return Node pointer
+*/
+QTree_t *qtree_t__alloc(QTree_t *self, SDL_FRect rect)
+{
+	size_t		   i;
+	QTree_t		  *node = NULL;
+	qtree_pool_t	 *pool = NULL;
+	qtree_slab_t	 *slab = NULL;
+	
+	pool = self->qtree.pool;
+	
+	if (!pool->free)
+	{
+		slab = calloc(1, sizeof(qtree_slab_t));
+		slab->next = pool->slab;
+		pool->slab = slab;
+		
+		for (i = 0; i < QTREE_SLAB; ++i)
+		{
+			slab->node[i].qtree.tree[0] = pool->free;
+			pool->free = &(slab->node[i]);
+		}
+	}
+	
+	node = pool->free;
+	pool->free = node->qtree.tree[0];
+	
+	node->type = QTREE;
+	node->qtree.rect = rect;
+	node->qtree.pool = pool;
+	qtree_t__ctor(node);
+	node->qtree.parent = self;
+	node->qtree.depth = self->qtree.depth + 1;
+	node->qtree.loose = self->qtree.loose;
+	
+	return node;
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__free(QTree_t *self)
+	@brief Give back an empty node to the tree pool, its content array is kept for reuse
+	@param self Object pointer
+	@return void
+*/
+void qtree_t__free(QTree_t *self)
+{
+	qtree_pool_t *pool = NULL;
+	
+	pool = self->qtree.pool;
+	self->qtree.tree[0] = pool->free;
+	pool->free = self;
+}
+
+/**
+	@relates qtree_s
+	@fn uint8_t qtree_t__isLeaf(QTree_t *self)
+	@brief Test if a node has no children
+	@param self Object pointer
+	@return Boolean TRUE if the node is a leaf
+*/
+uint8_t qtree_t__isLeaf(QTree_t *self)
+{
+	return !(
+		self->qtree.tree[0] ||
+		self->qtree.tree[1] ||
+		self->qtree.tree[2] ||
+		self->qtree.tree[3]
+	);
+}
+
+/**
+	@relates qtree_s
+	@fn SDL_FRect qtree_t__bounds(QTree_t *self)
+	@brief Get the area holding a node elements, loose nodes overlap their neighbours by half their size
+	and point nodes are grown by the farthest a hitbox reaches out of its element position
+	@param self Object pointer
+	@return Node bounds
+*/
+SDL_FRect qtree_t__bounds(QTree_t *self)
+{
+	SDL_FRect		rect;
+	qtree_pool_t	 *pool = NULL;
+	
+	rect = self->qtree.rect;
+	
+	if (self->qtree.loose)
+	{
+		rect.x -= rect.w / 2;
+		rect.y -= rect.h / 2;
+		rect.w *= 2;
+		rect.h *= 2;
+	}
+	else
+	{
+		pool = self->qtree.pool;
+		rect.x -= pool->reach.x;
+		rect.y -= pool->reach.y;
+		rect.w += pool->reach.x + pool->reach.w;
+		rect.h += pool->reach.y + pool->reach.h;
+	}
+	
+	return rect;
+}
+
+/**
+	@relates qtree_s
+	@fn SDL_FPoint qtree_t__point(QTree_t *self, Entity_t *content)
+	@brief Get the point placing an element, its hitbox center in loose mode and its position otherwise
+	@param self Object pointer
+	@param content Element pointer
+	@return Element point
+*/
+SDL_FPoint qtree_t__point(QTree_t *self, Entity_t *content)
+{
+	SDL_FRect	 rect;
+	SDL_FPoint	point;
+	
+	if (!self->qtree.loose)
+		return content->entity.vtable->getPosition(content);
+	
+	rect = content->entity.vtable->getHitbox(content);
+	point.x = rect.x + rect.w / 2;
+	point.y = rect.y + rect.h / 2;
+	
+	return point;
+}
+
+/**
+	@relates qtree_s
+	@fn uint8_t qtree_t__holds(QTree_t *self, SDL_FRect rect)
+	@brief Test if a hitbox can go down in a child of a loose node
+	@param self Object pointer
+	@param rect Element hitbox
+	@return Boolean TRUE if the hitbox fits in a child
+	
+	@note Hitboxes centered out of the node stay in it, like out of the root ones
+*/
+uint8_t qtree_t__holds(QTree_t *self, SDL_FRect rect)
+{
+	SDL_FPoint	point;
+	
+	point.x = rect.x + rect.w / 2;
+	point.y = rect.y + rect.h / 2;
+	
+	return rect.w <= self->qtree.rect.w / 2 &&
+		rect.h <= self->qtree.rect.h / 2 &&
+		SDL_PointInFRect(&point, &(self->qtree.rect));
+}
+
+/**
+	@relates qtree_s
+	@fn uint8_t qtree_t__fits(QTree_t *self, Entity_t *content)
+	@brief Test if an element can go down in a child of a node
+	@param self Object pointer
+	@param content Element pointer
+	@return Boolean TRUE if the element fits in a child
+*/
+uint8_t qtree_t__fits(QTree_t *self, Entity_t *content)
+{
+	if (!self->qtree.loose)
+		return 1;
+	
+	return qtree_t__holds(self, content->entity.vtable->getHitbox(content));
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__append(QTree_t *self, Entity_t *content)
+	@brief Append element in the node content, growing it past capacity as an overflow bucket.
+	In point mode the pool reach is widened to the element hitbox
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+*/
+void qtree_t__append(QTree_t *self, Entity_t *content)
+{
+	SDL_FRect		rect;
+	SDL_FPoint	   point;
+	qtree_pool_t	 *pool = NULL;
+	
+	if (!self->qtree.loose)
+	{
+		pool = self->qtree.pool;
+		rect = content->entity.vtable->getHitbox(content);
+		point = content->entity.vtable->getPosition(content);
+		pool->reach.x = MAX(pool->reach.x, point.x - rect.x);
+		pool->reach.y = MAX(pool->reach.y, point.y - rect.y);
+		pool->reach.w = MAX(pool->reach.w, rect.x + rect.w - point.x);
+		pool->reach.h = MAX(pool->reach.h, rect.y + rect.h - point.y);
+	}
+	
+	if (self->qtree.count == self->qtree.size)
+	{
+		self->qtree.size *= 2;
+		self->qtree.content = realloc(
+			self->qtree.content,
+			self->qtree.size * sizeof(Entity_t *)
+		);
+	}
+	
+	self->qtree.content[self->qtree.count] = content;
+	content->entity.vtable->setNode(content, self, self->qtree.count);
+	self->qtree.count++;
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__detach(QTree_t *self, size_t slot)
+	@brief Remove the element of a content slot, the last element takes its slot
+	@param self Object pointer
+	@param slot Content slot
+	@return void
+*/
+void qtree_t__detach(QTree_t *self, size_t slot)
+{
+	Entity_t *elem = NULL;
+	
+	elem = self->qtree.content[slot];
+	elem->entity.vtable->setNode(elem, NULL, 0);
+	
+	self->qtree.count--;
+	
+	if (slot < self->qtree.count)
+	{
+		elem = self->qtree.content[self->qtree.count];
+		self->qtree.content[slot] = elem;
+		elem->entity.vtable->setNode(elem, self, slot);
+	}
+}
+
+/**
+	@relates qtree_s
+	@fn layer_t qtree_t__summarize(QTree_t *self)
+	@brief Recompute the layers summary of a node from its content and children
+	@param self Object pointer
+	@return Node layers
+*/
+layer_t qtree_t__summarize(QTree_t *self)
+{
+	size_t	   i;
+	layer_t	  layer = NO_LAYER;
+	Entity_t	 *elem = NULL;
+	
+	for (i = 0; i < self->qtree.count; ++i)
+	{
+		elem = self->qtree.content[i];
+		layer |= elem->entity.vtable->getLayer(elem);
+	}
+	
+	for (i = 0; i < 4; ++i)
+	{
+		if (self->qtree.tree[i])
+			layer |= self->qtree.tree[i]->qtree.layer;
+	}
+	
+	self->qtree.layer = layer;
+	
+	return layer;
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__collapse(QTree_t *self)
+	@brief Merge children leaves back into their parent while they fit in it, up to the root
+	@param self Object pointer
+	@return void
+*/
+void qtree_t__collapse(QTree_t *self)
+{
+	size_t		i, j;
+	size_t		count;
+	uint8_t	   flag;
+	QTree_t	   *qtree = NULL;
+	
+	while (self && !qtree_t__isLeaf(self))
+	{
+		count = self->qtree.count;
+		flag = 1;
+		
+		for (i = 0; i < 4; ++i)
+		{
+			qtree = self->qtree.tree[i];
+			
+			if (qtree)
+			{
+				count += qtree->qtree.count;
+				flag &= qtree_t__isLeaf(qtree);
+			}
+		}
+		
+		if (!flag || count > self->qtree.pool->capacity)
+			return;
+		
+		for (i = 0; i < 4; ++i)
+		{
+			qtree = self->qtree.tree[i];
+			
+			if (qtree)
+			{
+				for (j = 0; j < qtree->qtree.count; ++j)
+					qtree_t__append(self, qtree->qtree.content[j]);
+				
+				qtree->qtree.count = 0;
+				qtree_t__free(qtree);
+				self->qtree.tree[i] = NULL;
+			}
+		}
+		
+		self = self->qtree.parent;
+	}
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__level(QTree_t *self, size_t depth)
+	@brief Set the depth of a node and its subtree
+	@param self Object pointer
+	@param depth Node depth
+	@return void
+*/
+void qtree_t__level(QTree_t *self, size_t depth)
+{
+	size_t i;
+	
+	self->qtree.depth = depth;
+	
+	for (i = 0; i < 4; ++i)
+	{
+		if (self->qtree.tree[i])
+			qtree_t__level(self->qtree.tree[i], depth + 1);
+	}
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__adopt(QTree_t *self, QTree_t *qtree)
+	@brief Move the content and children of a node into another one
+	@param self Object pointer receiving the node data
+	@param qtree Node giving its data, left empty
+	@return void
+*/
+void qtree_t__adopt(QTree_t *self, QTree_t *qtree)
+{
+	size_t		i;
+	size_t		size;
+	Entity_t	  **content = NULL;
+	
+	content = self->qtree.content;
+	size = self->qtree.size;
+	self->qtree.content = qtree->qtree.content;
+	self->qtree.size = qtree->qtree.size;
+	self->qtree.count = qtree->qtree.count;
+	self->qtree.layer = qtree->qtree.layer;
+	qtree->qtree.content = content;
+	qtree->qtree.size = size;
+	qtree->qtree.count = 0;
+	qtree->qtree.layer = NO_LAYER;
+	
+	for (i = 0; i < self->qtree.count; ++i)
+		self->qtree.content[i]->entity.vtable->setNode(self->qtree.content[i], self, i);
+	
+	for (i = 0; i < 4; ++i)
+	{
+		self->qtree.tree[i] = qtree->qtree.tree[i];
+		qtree->qtree.tree[i] = NULL;
+		
+		if (self->qtree.tree[i])
+			self->qtree.tree[i]->qtree.parent = self;
+	}
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__grow(QTree_t *self, SDL_FPoint point)
+	@brief Double the root area toward a point until it holds it, the old root becomes a child
+	@param self Object pointer
+	@param point Point to hold
+	@return void
+	
+	@note Growth stops after QTREE_GROWTH doublings, an empty root only widens its area
+*/
+void qtree_t__grow(QTree_t *self, SDL_FPoint point)
+{
+	size_t		i;
+	size_t		j;
+	QTree_t	   *qtree = NULL;
+	SDL_FRect	 rect;
+	
+	for (i = 0; i < QTREE_GROWTH && !SDL_PointInFRect(&point, &(self->qtree.rect)); ++i)
+	{
+		rect = self->qtree.rect;
+		j = (point.x < rect.x) + 2 * (point.y < rect.y);
+		
+		if (self->qtree.count || !qtree_t__isLeaf(self))
+		{
+			qtree = qtree_t__alloc(self, rect);
+			qtree_t__adopt(qtree, self);
+			qtree_t__level(qtree, 1);
+			
+			self->qtree.tree[j] = qtree;
+			self->qtree.layer = qtree->qtree.layer;
+		}
+		
+		self->qtree.rect.x -= (j % 2) * rect.w;
+		self->qtree.rect.y -= (j / 2) * rect.h;
+		self->qtree.rect.w *= 2;
+		self->qtree.rect.h *= 2;
+	}
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__shrink(QTree_t *self)
+	@brief Make the only populated child of the root the new root, down to the root initial size
+	@param self Object pointer
+	@return void
+*/
+void qtree_t__shrink(QTree_t *self)
+{
+	size_t		i;
+	size_t		count;
+	QTree_t	   *qtree = NULL;
+	
+	while (!self->qtree.count && !qtree_t__isLeaf(self))
+	{
+		count = 0;
+		
+		for (i = 0; i < 4; ++i)
+		{
+			if (self->qtree.tree[i] &&
+				(self->qtree.tree[i]->qtree.count || !qtree_t__isLeaf(self->qtree.tree[i])))
+			{
+				qtree = self->qtree.tree[i];
+				count++;
+			}
+		}
+		
+		if (count != 1 ||
+			qtree->qtree.rect.w < self->qtree.pool->width ||
+			qtree->qtree.rect.h < self->qtree.pool->height)
+			return;
+		
+		for (i = 0; i < 4; ++i)
+		{
+			if (self->qtree.tree[i] && self->qtree.tree[i] != qtree)
+				qtree_t__free(self->qtree.tree[i]);
+		}
+		
+		self->qtree.rect = qtree->qtree.rect;
+		qtree_t__adopt(self, qtree);
+		qtree_t__free(qtree);
+		qtree_t__level(self, 0);
+	}
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__descend(QTree_t *self, Entity_t *content)
+	@brief Insert element in the child of a node holding its point
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+	
+	@note Elements out of the node area go to the closest child, dirty ones are fixed by update
+*/
+void qtree_t__descend(QTree_t *self, Entity_t *content)
+{
+	size_t		j;
+	QTree_t	   *qtree = NULL;
+	SDL_FRect	 rect;
+	SDL_FPoint	point;
+	
+	rect.w = self->qtree.rect.w / 2;
+	rect.h = self->qtree.rect.h / 2;
+	point = qtree_t__point(self, content);
+	j = (point.x >= self->qtree.rect.x + rect.w) + 2 * (point.y >= self->qtree.rect.y + rect.h);
+	
+	if (!self->qtree.tree[j])
+	{
+		rect.x = self->qtree.rect.x + (j % 2) * rect.w;
+		rect.y = self->qtree.rect.y + (j / 2) * rect.h;
+		self->qtree.tree[j] = qtree_t__alloc(self, rect);
+	}
+	
+	qtree = self->qtree.tree[j];
+	qtree->qtree.vtable->insert(qtree, content);
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__insert(QTree_t *self, Entity_t *content)
+	@brief Insert element
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+	
+	@note A leaf splits past capacity, at maximal depth it grows as an overflow bucket.
+	In loose mode elements too large for a child stay in the node.
+	The root grows to hold elements out of its area.
+*/
+void qtree_t__insert(QTree_t *self, Entity_t *content)
+{
+	size_t		i;
+	size_t		count;
+	Entity_t	  *elem = NULL;
+
+	if (!content->entity.vtable->getSpace(content))
+		content->entity.vtable->setSpace(content, self);
+	
+	if (self == self->qtree.pool->root)
+		qtree_t__grow(self, qtree_t__point(self, content));
+	
+	self->qtree.layer |= content->entity.vtable->getLayer(content);
+	
+	if (qtree_t__isLeaf(self))
+	{
+		if (self->qtree.count < self->qtree.pool->capacity ||
+			self->qtree.depth >= self->qtree.pool->depth)
+		{
+			qtree_t__append(self, content);
+			return;
+		}
+		
+		count = self->qtree.count;
+		self->qtree.count = 0;
+		
+		for (i = 0; i < count; ++i)
+		{
+			elem = self->qtree.content[i];
+			
+			if (qtree_t__fits(self, elem))
+			{
+				elem->entity.vtable->setNode(elem, NULL, 0);
+				qtree_t__descend(self, elem);
+			} else
+				qtree_t__append(self, elem);
+		}
+	}
+	
+	if (qtree_t__fits(self, content))
+		qtree_t__descend(self, content);
+	else
+		qtree_t__append(self, content);
+}
+
+/**
+	@relates qtree_s
+	@fn size_t qtree_t__partition(qtree_bulk_t *bulk, size_t count, size_t axis, float split)
+	@brief Move the elements placed before a split line at the front of a bulk array
+	@param bulk Bulk array
+	@param count Elements count
+	@param axis 0 to split on x, 1 to split on y
+	@param split Split line
+	@return Count of elements before the split line
+*/
+size_t qtree_t__partition(qtree_bulk_t *bulk, size_t count, size_t axis, float split)
+{
+	size_t		 i;
+	size_t		 front = 0;
+	qtree_bulk_t   elem;
+	
+	for (i = 0; i < count; ++i)
+	{
+		if ((axis ? bulk[i].point.y : bulk[i].point.x) < split)
+		{
+			elem = bulk[front];
+			bulk[front++] = bulk[i];
+			bulk[i] = elem;
+		}
+	}
+	
+	return front;
+}
+
+/**
+	@relates qtree_s
+	@fn layer_t qtree_t__bulk(QTree_t *self, qtree_bulk_t *bulk, size_t count)
+	@brief Build an empty node subtree from a bulk array in one pass
+	@param self Object pointer
+	@param bulk Bulk array, reordered by quadrant
+	@param count Elements count
+	@return Layers summary of the subtree
+*/
+layer_t qtree_t__bulk(QTree_t *self, qtree_bulk_t *bulk, size_t count)
+{
+	size_t		 i, j;
+	size_t		 front = 0;
+	size_t		 bound[5];
+	qtree_bulk_t   elem;
+	SDL_FRect	  rect;
+	
+	if (count <= self->qtree.pool->capacity ||
+		self->qtree.depth >= self->qtree.pool->depth)
+	{
+		for (i = 0; i < count; ++i)
+		{
+			qtree_t__append(self, bulk[i].content);
+			self->qtree.layer |= bulk[i].layer;
+		}
+		
+		return self->qtree.layer;
+	}
+	
+	for (i = 0; self->qtree.loose && i < count; ++i)
+	{
+		if (!qtree_t__holds(self, bulk[i].rect))
+		{
+			qtree_t__append(self, bulk[i].content);
+			self->qtree.layer |= bulk[i].layer;
+			elem = bulk[front];
+			bulk[front++] = bulk[i];
+			bulk[i] = elem;
+		}
+	}
+	
+	rect.w = self->qtree.rect.w / 2;
+	rect.h = self->qtree.rect.h / 2;
+	
+	bound[0] = front;
+	bound[4] = count;
+	bound[2] = front + qtree_t__partition(bulk + front, count - front, 1, self->qtree.rect.y + rect.h);
+	bound[1] = front + qtree_t__partition(bulk + front, bound[2] - front, 0, self->qtree.rect.x + rect.w);
+	bound[3] = bound[2] + qtree_t__partition(bulk + bound[2], count - bound[2], 0, self->qtree.rect.x + rect.w);
+	
+	for (j = 0; j < 4; ++j)
+	{
+		if (bound[j + 1] > bound[j])
+		{
+			rect.x = self->qtree.rect.x + (j % 2) * rect.w;
+			rect.y = self->qtree.rect.y + (j / 2) * rect.h;
+			self->qtree.tree[j] = qtree_t__alloc(self, rect);
+			self->qtree.layer |= qtree_t__bulk(self->qtree.tree[j], bulk + bound[j], bound[j + 1] - bound[j]);
+		}
+	}
+	
+	return self->qtree.layer;
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__build(QTree_t *self, Entity_t **content, size_t count)
+	@brief Insert an elements array at once, an empty tree is built balanced in one pass
+	@param self Object pointer
+	@param content Elements array
+	@param count Elements count
+	@return void
+	
+	@note Elements are read once then partitioned by quadrant down to their final nodes.
+	A tree which already holds elements falls back to one insert per element.
+*/
+void qtree_t__build(QTree_t *self, Entity_t **content, size_t count)
+{
+	size_t		 i;
+	qtree_bulk_t  *bulk = NULL;
+	
+	if (self != self->qtree.pool->root ||
+		self->qtree.count ||
+		!qtree_t__isLeaf(self) ||
+		!(bulk = malloc(count * sizeof(qtree_bulk_t))))
+	{
+		for (i = 0; i < count; ++i)
+			self->qtree.vtable->insert(self, content[i]);
+		
+		return;
+	}
+	
+	for (i = 0; i < count; ++i)
+	{
+		if (!content[i]->entity.vtable->getSpace(content[i]))
+			content[i]->entity.vtable->setSpace(content[i], self);
+		
+		bulk[i].content = content[i];
+		bulk[i].layer = content[i]->entity.vtable->getLayer(content[i]);
+		bulk[i].point = qtree_t__point(self, content[i]);
+		
+		if (self->qtree.loose)
+			bulk[i].rect = content[i]->entity.vtable->getHitbox(content[i]);
+		
+		if (!SDL_PointInFRect(&(bulk[i].point), &(self->qtree.rect)))
+			qtree_t__grow(self, bulk[i].point);
+	}
+	
+	qtree_t__bulk(self, bulk, count);
+	free(bulk);
+}
+
+/**
+	@relates qtree_s
+	@fn uint8_t qtree_t__remove(QTree_t *self, Entity_t *content)
+	@brief Remove element from its leaf in constant time
+	@param self Object pointer
+	@param content Element pointer
+	@return Boolean TRUE if the element was in the quadtree
+*/
+uint8_t qtree_t__remove(QTree_t *self, Entity_t *content)
+{
+	Entity_t		 *elem = NULL;
+	QTree_t		  *qtree = NULL;
+	qtree_pool_t	 *pool = NULL;
+	entity_node_t	node;
+	
+	pool = self->qtree.pool;
+	node = content->entity.vtable->getNode(content);
+	
+	if (!node.leaf || node.leaf->type != QTREE || node.leaf->qtree.pool != pool)
+		return 0;
+	
+	if (node.dirty)
+	{
+		elem = pool->dirty[--pool->count];
+		pool->dirty[node.mark] = elem;
+		elem->entity.vtable->setMark(elem, node.mark);
+		content->entity.vtable->setDirty(content, 0);
+	}
+	
+	qtree_t__detach(node.leaf, node.slot);
+	content->entity.vtable->setSpace(content, NULL);
+	
+	for (qtree = node.leaf; qtree; qtree = qtree->qtree.parent)
+		qtree_t__summarize(qtree);
+	
+	qtree_t__collapse(node.leaf->qtree.parent);
+	
+	return 1;
+}
+
 /**
 	@relates qtree_s
-	@fn void qtree_t__insert(QTree_t *self, Entity_t *content)
-	@brief Insert element
+	@fn void qtree_t__move(QTree_t *self, Entity_t *content, SDL_FPoint from)
+	@brief Re-home a moved element from its node through the closest ancestor holding it
 	@param self Object pointer
 	@param content Element pointer
+	@param from Element position before it moved
 	@return void
 */
-void qtree_t__insert(QTree_t *self, Entity_t *content)
+void qtree_t__move(QTree_t *self, Entity_t *content, SDL_FPoint from)
 {
-	size_t		i, j;
-	size_t		bound;
-	size_t		flag = (size_t) NULL;
-	QTree_t	   *qtree = NULL;
-	Entity_t	  *elem = NULL;
-	SDL_FRect	 rect;
-	SDL_FPoint	point;
+	QTree_t		  *qtree = NULL;
+	SDL_FPoint	   point;
+	entity_node_t	node;
+	
+	node = content->entity.vtable->getNode(content);
+	point = content->entity.vtable->getPosition(content);
+	
+	if (!node.leaf || node.leaf->qtree.pool != self->qtree.pool)
+		return;
+	
+	if (point.x == from.x && point.y == from.y)
+		return;
+	
+	point = qtree_t__point(self, content);
+	
+	if (SDL_PointInFRect(&point, &(node.leaf->qtree.rect)))
+		return;
+	
+	qtree_t__detach(node.leaf, node.slot);
+	
+	qtree = node.leaf->qtree.parent;
+	while (qtree && !SDL_PointInFRect(&point, &(qtree->qtree.rect)))
+		qtree = qtree->qtree.parent;
+	
+	if (!qtree)
+		qtree = self->qtree.pool->root;
+	
+	qtree->qtree.vtable->insert(qtree, content);
+	
+	for (qtree = node.leaf; qtree; qtree = qtree->qtree.parent)
+		qtree_t__summarize(qtree);
+	
+	qtree_t__collapse(node.leaf->qtree.parent);
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__mark(QTree_t *self, Entity_t *content)
+	@brief Add a moving element to the dirty set handled by the next update
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+*/
+void qtree_t__mark(QTree_t *self, Entity_t *content)
+{
+	qtree_pool_t *pool = NULL;
+	
+	pool = self->qtree.pool;
+	
+	if (pool->count == pool->size)
+	{
+		pool->size = pool->size ? 2 * pool->size : QTREE_SLAB;
+		pool->dirty = realloc(pool->dirty, pool->size * sizeof(Entity_t *));
+	}
+	
+	content->entity.vtable->setMark(content, pool->count);
+	pool->dirty[pool->count++] = content;
+}
 
-	if (!content->entity.getQTree(content))
-		content->entity.setQTree(content, self);
+/**
+	@relates qtree_s
+	@fn void qtree_t__visit(QTree_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data)
+	@brief Call back every element of the layers in rect area without allocating
+	@param self Object pointer
+	@param rect Area
+	@param layer Layers mask, subtrees without these layers are skipped
+	@param callback Function called with each element and data
+	@param data User pointer given to callback
+	@return void
+*/
+void qtree_t__visit(QTree_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data)
+{
+	size_t	   i;
+	QTree_t	  *qtree = NULL;
+	Entity_t	 *elem = NULL;
+	SDL_FRect	subrect;
 	
-	point = content->entity.getPosition(content);
+	if (!(self->qtree.layer & layer))
+		return;
 	
-	for (i = 0; i < 4; ++i)
-		flag |= (size_t) self->qtree.tree[i];
+	for (i = 0; i < self->qtree.count; ++i)
+	{
+		elem = self->qtree.content[i];
+		subrect = elem->entity.vtable->getHitbox(elem);
+
+		if (elem->entity.vtable->getLayer(elem) & layer &&
+			SDL_HasIntersectionF(&subrect, &rect))
+			callback(elem, data);
+	}
 	
-	bound = flag ? 0 : 4;
-	for (i = 0; i < bound; ++i)
+	for (i = 0; i < 4; ++i)
 	{
-		if (!self->qtree.content[i])
+		if (self->qtree.tree[i])
 		{
-			self->qtree.content[i] = content;
-			return;
+			qtree = self->qtree.tree[i];
+			subrect = qtree_t__bounds(qtree);
+
+			if (qtree->qtree.layer & layer &&
+				SDL_HasIntersectionF(&subrect, &rect))
+				qtree->qtree.vtable->visit(qtree, rect, layer, callback, data);
 		}
 	}
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__answer(QTree_t *self, Batch_t *batch, size_t from, size_t count)
+	@brief Test a node elements against the queries crossing it, then descend with the
+	queries crossing each child, so a node is opened once for the whole batch
+	@param self Object pointer
+	@param batch Batch pointer
+	@param from First index of the queries on the batch active stack
+	@param count Number of queries
+	@return void
+*/
+void qtree_t__answer(QTree_t *self, Batch_t *batch, size_t from, size_t count)
+{
+	size_t	   i, j;
+	size_t	   top;
+	size_t	   query;
+	QTree_t	  *qtree = NULL;
+	Entity_t	 *elem = NULL;
+	SDL_FRect	subrect;
 	
-	bound++;
-	rect.w = self->qtree.rect.w / 2;
-	rect.h = self->qtree.rect.h / 2;
-	
-	for (i = 0; i < bound; ++i)
+	for (i = 0; i < self->qtree.count; ++i)
 	{
-		elem = content;
-		if (!flag && i < 4)
+		elem = self->qtree.content[i];
+		
+		if (!(elem->entity.vtable->getLayer(elem) & batch->batch.layer))
+			continue;
+		
+		subrect = elem->entity.vtable->getHitbox(elem);
+		
+		for (j = 0; j < count; ++j)
 		{
-			elem = self->qtree.content[i];
-			self->qtree.content[i] = NULL;
+			query = batch->batch.active[from + j];
+			
+			if (SDL_HasIntersectionF(&subrect, &(batch->batch.rect[query])))
+				batch->batch.vtable->push(batch, query, elem);
 		}
+	}
+	
+	for (i = 0; i < 4; ++i)
+	{
+		qtree = self->qtree.tree[i];
+		
+		if (!qtree || !(qtree->qtree.layer & batch->batch.layer))
+			continue;
 		
-		point = elem->entity.getPosition(elem);
+		subrect = qtree_t__bounds(qtree);
+		top = batch->batch.used;
+		batch->batch.vtable->reserve(batch, count);
 		
-		for (j = 0; j < 4; ++j)
+		for (j = 0; j < count; ++j)
 		{
-			rect.x = self->qtree.rect.x + (j % 2) * rect.w;
-			rect.y = self->qtree.rect.y + (j / 2) * rect.h;
+			query = batch->batch.active[from + j];
 			
-			if (SDL_PointInFRect(&point, &rect))
-			{
-				if (!self->qtree.tree[j])
-					self->qtree.tree[j] = QTree(rect);
-
-				qtree = self->qtree.tree[j];
-				qtree->qtree.insert(qtree, elem);
-				break;
-			}
+			if (SDL_HasIntersectionF(&subrect, &(batch->batch.rect[query])))
+				batch->batch.active[batch->batch.used++] = query;
 		}
+		
+		if (batch->batch.used > top)
+			qtree_t__answer(qtree, batch, top, batch->batch.used - top);
+		
+		batch->batch.used = top;
 	}
 }
 
 /**
 	@relates qtree_s
-	@fn uint8_t qtree_t__remove(QTree_t *self, Entity_t *content)
-	@brief Remove element
+	@fn void qtree_t__query(QTree_t *self, Batch_t *batch)
+	@brief Answer every query of a batch in a single traversal
 	@param self Object pointer
-	@param content Element pointer
-	@return Boolean for recurrent algorithm
+	@param batch Batch pointer
+	@return void
 */
-uint8_t qtree_t__remove(QTree_t *self, Entity_t *content)
+void qtree_t__query(QTree_t *self, Batch_t *batch)
 {
-	size_t		i;
-	QTree_t	   *qtree = NULL;
-	SDL_FPoint	point;
+	size_t i;
 	
-	point = content->entity.getPosition(content);
+	if (!(self->qtree.layer & batch->batch.layer))
+		return;
 	
-	if (!SDL_PointInFRect(&point, &(self->qtree.rect)))
-		return 0;
+	batch->batch.vtable->reserve(batch, batch->batch.count);
 	
-	for (i = 0; i < 4; ++i)
+	/* The root also holds elements out of its rect, every query starts there */
+	for (i = 0; i < batch->batch.count; ++i)
+		batch->batch.active[batch->batch.used + i] = i;
+	
+	batch->batch.used += batch->batch.count;
+	qtree_t__answer(self, batch, batch->batch.used - batch->batch.count, batch->batch.count);
+	batch->batch.used -= batch->batch.count;
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__sift(qtree_near_t *heap, size_t count, size_t slot, int order)
+	@brief Move a heap entry down to its place
+	@param heap Binary heap
+	@param count Heap length
+	@param slot Entry index
+	@param order 1 for a min-heap, -1 for a max-heap on distance
+	@return void
+*/
+void qtree_t__sift(qtree_near_t *heap, size_t count, size_t slot, int order)
+{
+	size_t		   child;
+	qtree_near_t	 swap;
+	
+	while ((child = 2 * slot + 1) < count)
 	{
-		if (self->qtree.content[i] == content)
-		{
-			self->qtree.content[i] = NULL;
-			content->entity.setQTree(content, NULL);
-			return 1;
-		}
+		if (child + 1 < count &&
+			order * (heap[child + 1].distance - heap[child].distance) < 0)
+			++child;
 		
-		if (self->qtree.tree[i])
-		{
-			qtree = self->qtree.tree[i];
-			
-			if (qtree->qtree.remove(qtree, content))
-				return 1;
-		}
+		if (order * (heap[child].distance - heap[slot].distance) >= 0)
+			break;
+		
+		swap = heap[slot];
+		heap[slot] = heap[child];
+		heap[child] = swap;
+		slot = child;
 	}
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__raise(qtree_near_t *heap, size_t slot, int order)
+	@brief Move a heap entry up to its place
+	@param heap Binary heap
+	@param slot Entry index
+	@param order 1 for a min-heap, -1 for a max-heap on distance
+	@return void
+*/
+void qtree_t__raise(qtree_near_t *heap, size_t slot, int order)
+{
+	size_t		   parent;
+	qtree_near_t	 swap;
 	
-	return 0;
+	while (slot)
+	{
+		parent = (slot - 1) / 2;
+		
+		if (order * (heap[slot].distance - heap[parent].distance) >= 0)
+			break;
+		
+		swap = heap[slot];
+		heap[slot] = heap[parent];
+		heap[parent] = swap;
+		slot = parent;
+	}
 }
 
 /**
 	@relates qtree_s
-	@fn CList_t *qtree_t__fetch(QTree_t *self, SDL_FRect rect)
-	@brief Fetch elements in rect area
+	@fn void qtree_t__visitCircle(QTree_t *self, SDL_FPoint center, float radius, layer_t layer, space_visit_t callback, void *data)
+	@brief Call back every element of the layers whose hitbox touches the circle,
+	subtrees whose bounds are farther than radius are skipped
 	@param self Object pointer
-	@param rect Area
-	@return Chained list of elements
+	@param center Circle center
+	@param radius Circle radius
+	@param layer Layers mask
+	@param callback Function called with each element and data
+	@param data User pointer given to callback
+	@return void
 */
-CList_t *qtree_t__fetch(QTree_t *self, SDL_FRect rect)
+void qtree_t__visitCircle(QTree_t *self, SDL_FPoint center, float radius, layer_t layer, space_visit_t callback, void *data)
 {
 	size_t	   i;
-	CList_t	  *list = NULL;
-	CList_t	  *sublist = NULL;
+	float		limit;
 	QTree_t	  *qtree = NULL;
 	Entity_t	 *elem = NULL;
-	SDL_FRect	subrect;
 	
-	list = CList();
+	if (!(self->qtree.layer & layer))
+		return;
 	
-	for (i = 0; i < 4; ++i)
+	limit = radius * radius;
+	
+	for (i = 0; i < self->qtree.count; ++i)
 	{
-		if (self->qtree.content[i])
-		{
-			elem = self->qtree.content[i];
-			subrect = elem->entity.getHitbox(elem);
-
-			if (SDL_HasIntersectionF(&subrect, &rect))
-				list->clist.push(list, elem);
-		}
-		
-		if (self->qtree.tree[i])
-		{
-			qtree = self->qtree.tree[i];
-			subrect = qtree->qtree.rect;
+		elem = self->qtree.content[i];
 
-			if (SDL_HasIntersectionF(&subrect, &rect))
-			{
-				sublist = qtree->qtree.fetch(qtree, rect);
-				
-				elem = sublist->clist.pop(sublist);
-				while (elem)
-				{
-					list->clist.push(list, elem);
-					elem = sublist->clist.pop(sublist);
-				}
-				
-				delete(sublist);
-			}
-		}
+		if (elem->entity.vtable->getLayer(elem) & layer &&
+			space_t__distance(elem->entity.vtable->getHitbox(elem), center) <= limit)
+			callback(elem, data);
 	}
 	
-	return list;
+	for (i = 0; i < 4; ++i)
+	{
+		qtree = self->qtree.tree[i];
+
+		if (qtree && qtree->qtree.layer & layer &&
+			space_t__distance(qtree_t__bounds(qtree), center) <= limit)
+			qtree->qtree.vtable->visitCircle(qtree, center, radius, layer, callback, data);
+	}
 }
 
 /**
 	@relates qtree_s
-	@fn void qtree_t__update(QTree_t *self)
-	@brief Update elements position in quadtree and clean unused quadtree
+	@fn size_t qtree_t__nearest(QTree_t *self, SDL_FPoint point, layer_t layer, Entity_t **result, size_t count)
+	@brief Find the elements of the layers nearest to a point, measured to their hitbox.
+	Nodes are opened best-first from a distance queue and the search stops
+	as soon as the next node is farther than the current count-th element
 	@param self Object pointer
-	@return void
+	@param point Query point
+	@param layer Layers mask
+	@param result Array receiving up to count elements, nearest first
+	@param count Number of elements wanted
+	@return Number of elements written in result
+	
+	@note The queues live in the tree pool, queries on one tree must not run concurrently
 */
-void qtree_t__update(QTree_t *self)
+size_t qtree_t__nearest(QTree_t *self, SDL_FPoint point, layer_t layer, Entity_t **result, size_t count)
 {
-	size_t		i, j;
-	size_t		count = 0;
-	size_t		flag = (size_t) NULL;
-	CList_t	   *elemlist = NULL;
-	CList_t	   *qtreelist = NULL;
-	QTree_t	   *subqtree = NULL;
-	Entity_t	  *elem = NULL;
-	SDL_FPoint	point;
+	size_t		   i;
+	size_t		   queued = 0;
+	size_t		   found = 0;
+	float			distance;
+	QTree_t		  *node = NULL;
+	QTree_t		  *qtree = NULL;
+	Entity_t		 *elem = NULL;
+	qtree_pool_t	 *pool = NULL;
+	
+	pool = self->qtree.pool;
+	
+	if (!count || !(self->qtree.layer & layer))
+		return 0;
 	
-	elemlist = CList();
-	qtreelist = CList();
-	qtreelist->clist.push(qtreelist, self);
+	if (pool->kept < count)
+	{
+		pool->kept = count;
+		pool->best = realloc(pool->best, pool->kept * sizeof(qtree_near_t));
+	}
 	
-	subqtree = qtreelist->clist.pop(qtreelist);
-	while (subqtree)
+	if (!pool->queued)
 	{
-		count = 0;
-		flag = (size_t) NULL;
+		pool->queued = QTREE_SLAB;
+		pool->queue = malloc(pool->queued * sizeof(qtree_near_t));
+	}
+	
+	pool->queue[queued].distance = 0;
+	pool->queue[queued++].node = self;
+	
+	while (queued)
+	{
+		node = pool->queue[0].node;
+		distance = pool->queue[0].distance;
+		pool->queue[0] = pool->queue[--queued];
+		qtree_t__sift(pool->queue, queued, 0, 1);
 		
-		for (i = 0; i < 4; ++i)
+		if (found == count && distance >= pool->best[0].distance)
+			break;
+		
+		for (i = 0; i < node->qtree.count; ++i)
 		{
-			if (subqtree->qtree.content[i])
+			elem = node->qtree.content[i];
+			
+			if (!(elem->entity.vtable->getLayer(elem) & layer))
+				continue;
+			
+			distance = space_t__distance(elem->entity.vtable->getHitbox(elem), point);
+			
+			if (found < count)
 			{
-				elem = subqtree->qtree.content[i];
-				point = elem->entity.getPosition(elem);
-				
-				if (!SDL_PointInFRect(&point, &(subqtree->qtree.rect)))
-				{
-					elemlist->clist.push(elemlist, elem);
-					subqtree->qtree.content[i] = NULL;
-				}
+				pool->best[found].distance = distance;
+				pool->best[found].content = elem;
+				qtree_t__raise(pool->best, found++, -1);
 			}
-			
-			if (subqtree->qtree.tree[i])
+			else if (distance < pool->best[0].distance)
 			{
-				for (j = 0; j < 4; ++j)
-				{
-					if (subqtree->qtree.tree[i]->qtree.content[j])
-						count++;
-					
-					flag |= (size_t) subqtree->qtree.tree[i]->qtree.tree[j];
-				}
+				pool->best[0].distance = distance;
+				pool->best[0].content = elem;
+				qtree_t__sift(pool->best, found, 0, -1);
 			}
 		}
 		
 		for (i = 0; i < 4; ++i)
 		{
-			if (subqtree->qtree.tree[i])
+			qtree = node->qtree.tree[i];
+			
+			if (!qtree || !(qtree->qtree.layer & layer))
+				continue;
+			
+			distance = space_t__distance(qtree_t__bounds(qtree), point);
+			
+			if (found == count && distance >= pool->best[0].distance)
+				continue;
+			
+			if (queued == pool->queued)
 			{
-				if (count < 5 && !flag)
-				{
-					for (j = 0; j < 4; ++j)
-					{
-						elem = subqtree->qtree.tree[i]->qtree.content[j];
-						
-						if (elem)
-						{
-							elemlist->clist.push(elemlist, elem);
-							subqtree->qtree.tree[i]->qtree.content[j] = NULL;
-						}
-					}
-					
-					delete(subqtree->qtree.tree[i]);
-					subqtree->qtree.tree[i] = NULL;
-				} else
-					qtreelist->clist.push(qtreelist, subqtree->qtree.tree[i]);
+				pool->queued *= 2;
+				pool->queue = realloc(pool->queue, pool->queued * sizeof(qtree_near_t));
 			}
+			
+			pool->queue[queued].distance = distance;
+			pool->queue[queued].node = qtree;
+			qtree_t__raise(pool->queue, queued++, 1);
+		}
+	}
+	
+	/* Draining the max-heap from its root gives the elements farthest first */
+	for (i = found; i > 0; --i)
+	{
+		result[i - 1] = pool->best[0].content;
+		pool->best[0] = pool->best[i - 1];
+		qtree_t__sift(pool->best, i - 1, 0, -1);
+	}
+	
+	return found;
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__ray(QTree_t *self, space_ray_t *ray)
+	@brief Test a node elements against the ray then walk its children front to back,
+	children entered after the nearest hit so far are skipped
+	@param self Object pointer
+	@param ray Ray state, time and hit are lowered on each nearer hit
+	@return void
+*/
+void qtree_t__ray(QTree_t *self, space_ray_t *ray)
+{
+	size_t	   i, j;
+	size_t	   count = 0;
+	float		enter, leave;
+	float		time[4];
+	QTree_t	  *order[4];
+	QTree_t	  *qtree = NULL;
+	Entity_t	 *elem = NULL;
+	
+	for (i = 0; i < self->qtree.count; ++i)
+	{
+		elem = self->qtree.content[i];
+		
+		/* A hitbox holding the ray start is the caster itself or something it already overlaps */
+		if (elem->entity.vtable->getLayer(elem) & ray->layer &&
+			space_t__slab(elem->entity.vtable->getHitbox(elem), ray->from, ray->move, &enter, &leave) &&
+			enter >= 0 && enter < ray->time)
+		{
+			ray->time = enter;
+			ray->hit = elem;
 		}
+	}
+	
+	for (i = 0; i < 4; ++i)
+	{
+		qtree = self->qtree.tree[i];
 		
-		subqtree = qtreelist->clist.pop(qtreelist);
+		if (!qtree || !(qtree->qtree.layer & ray->layer) ||
+			!space_t__slab(qtree_t__bounds(qtree), ray->from, ray->move, &enter, &leave) ||
+			enter >= ray->time)
+			continue;
+		
+		for (j = count++; j > 0 && time[j - 1] > enter; --j)
+		{
+			time[j] = time[j - 1];
+			order[j] = order[j - 1];
+		}
+		time[j] = enter;
+		order[j] = qtree;
 	}
 	
-	elem = elemlist->clist.pop(elemlist);
-	while (elem)
+	for (i = 0; i < count && time[i] < ray->time; ++i)
+		qtree_t__ray(order[i], ray);
+}
+
+/**
+	@relates qtree_s
+	@fn Entity_t *qtree_t__raycast(QTree_t *self, SDL_FPoint from, SDL_FPoint to, layer_t layer, float *time)
+	@brief Find the first element of the layers hit by the segment from-to
+	@param self Object pointer
+	@param from Segment start
+	@param to Segment end
+	@param layer Layers mask
+	@param time Receives the hit time between 0 and 1 along the segment, may be NULL
+	@return Element hit or NULL
+	
+	@note Hitboxes holding from are ignored so a ray cast from an element does not hit it
+*/
+Entity_t *qtree_t__raycast(QTree_t *self, SDL_FPoint from, SDL_FPoint to, layer_t layer, float *time)
+{
+	space_ray_t ray;
+	
+	ray.from = from;
+	ray.move.x = to.x - from.x;
+	ray.move.y = to.y - from.y;
+	ray.layer = layer;
+	ray.time = 1;
+	ray.hit = NULL;
+	
+	qtree_t__ray(self, &ray);
+	
+	if (time)
+		*time = ray.time;
+	
+	return ray.hit;
+}
+
+/**
+	@relates qtree_s
+	@fn void qtree_t__update(QTree_t *self)
+	@brief Move the dirty elements to their new leaf, leaves are merged where elements left
+	and the root shrinks around the populated area
+	@param self Object pointer
+	@return void
+	
+	@note Only elements moved through setDeltaPosition are seen by update
+*/
+void qtree_t__update(QTree_t *self)
+{
+	size_t			i;
+	Entity_t		  *elem = NULL;
+	qtree_pool_t	  *pool = NULL;
+	entity_node_t	 node;
+	
+	pool = self->qtree.pool;
+	
+	for (i = 0; i < pool->count; ++i)
 	{
-		self->qtree.insert(self, elem);
-		elem = elemlist->clist.pop(elemlist);
+		elem = pool->dirty[i];
+		node = elem->entity.vtable->getNode(elem);
+		elem->entity.vtable->setDirty(elem, 0);
+		pool->root->qtree.vtable->move(pool->root, elem, node.from);
 	}
 	
-	delete(qtreelist);
-	delete(elemlist);
+	pool->count = 0;
+	qtree_t__shrink(pool->root);
 }
 
 /**
@@ -298,47 +1322,106 @@ void qtree_t__draw(QTree_t *self, Window_t *window)
 {
 	size_t i;
 	
-	SDL_SetRenderTarget(window->window.renderer, window->window.camera.texture);
-	SDL_SetRenderDrawColor(window->window.renderer, 255, 0, 0, 255);
-	SDL_RenderDrawRectF(window->window.renderer, &(self->qtree.rect));
+	window->window.vtable->putRect(window, self->qtree.rect);
 	
 	for (i = 0; i < 4; ++i)
 	{
 		if (self->qtree.tree[i])
-			self->qtree.tree[i]->qtree.draw(self->qtree.tree[i], window);
+			self->qtree.tree[i]->qtree.vtable->draw(self->qtree.tree[i], window);
 	}
 }
 
+static const space_vtable_t qtree_vtable = {
+	&qtree_t__update,
+	&qtree_t__draw,
+	&qtree_t__insert,
+	&qtree_t__build,
+	&qtree_t__mark,
+	&qtree_t__visit,
+	&space_t__fetch,
+	&space_t__fetchLayer,
+	&qtree_t__query,
+	&space_t__fetchVector,
+	&space_t__fetchFrame,
+	&qtree_t__remove,
+	&qtree_t__move,
+	&qtree_t__visitCircle,
+	&qtree_t__nearest,
+	&qtree_t__raycast
+};
+
 retno_t qtree_t__ctor(QTree_t *self)
 {
 	size_t i;
 	
 	for (i = 0; i < 4; ++i)
-	{
-		self->qtree.content[i] = NULL;
 		self->qtree.tree[i] = NULL;
+	
+	/* A new root gets its capacity/depth from new(), they become the pool settings */
+	if (!self->qtree.pool)
+	{
+		self->qtree.pool = calloc(1, sizeof(qtree_pool_t));
+		self->qtree.pool->root = self;
+		self->qtree.pool->capacity = MAX(self->qtree.size, 1);
+		self->qtree.pool->depth = self->qtree.depth;
+		self->qtree.pool->width = self->qtree.rect.w;
+		self->qtree.pool->height = self->qtree.rect.h;
+		self->qtree.parent = NULL;
+		self->qtree.depth = 0;
+		self->qtree.size = 0;
 	}
 	
-	self->qtree.insert = &qtree_t__insert;
-	self->qtree.remove = &qtree_t__remove;
-	self->qtree.fetch = &qtree_t__fetch;
-	self->qtree.update = &qtree_t__update;
-	self->qtree.draw = &qtree_t__draw;
+	if (!self->qtree.content)
+	{
+		self->qtree.size = self->qtree.pool->capacity;
+		self->qtree.content = calloc(self->qtree.size, sizeof(Entity_t *));
+	}
+	
+	self->qtree.count = 0;
+	self->qtree.layer = NO_LAYER;
+	
+	self->qtree.vtable = &qtree_vtable;
 	
 	return SUCCESS;
 }
 
 retno_t qtree_t__dtor(QTree_t *self)
 {
-	size_t i;
+	size_t			i;
+	qtree_pool_t	  *pool = NULL;
+	qtree_slab_t	  *slab = NULL;
+	
+	for (i = 0; i < self->qtree.count; ++i)
+		delete(self->qtree.content[i]);
+	
+	self->qtree.count = 0;
 	
 	for (i = 0; i < 4; ++i)
 	{
-		if (self->qtree.content[i])
-			delete(self->qtree.content[i]);
-		
 		if (self->qtree.tree[i])
-			delete(self->qtree.tree[i]);
+			qtree_t__dtor(self->qtree.tree[i]);
+	}
+	
+	pool = self->qtree.pool;
+	
+	if (pool->root == self)
+	{
+		slab = pool->slab;
+		while (slab)
+		{
+			for (i = 0; i < QTREE_SLAB; ++i)
+				free(slab->node[i].qtree.content);
+			
+			pool->slab = slab->next;
+			free(slab);
+			slab = pool->slab;
+		}
+		
+		free(self->qtree.content);
+		free(pool->dirty);
+		free(pool->queue);
+		free(pool->best);
+		free(pool);
 	}
 	
 	return SUCCESS;
@@ -0,0 +1,212 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Scheduler.c
+*/
+
+#include <Base.h>
+#include <CVector.h>
+#include <Entity.h>
+#include <layer.h>
+#include <Scheduler.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Index of the lowest set bit, from the top five bits of its product with a de Bruijn sequence */
+static const uint8_t scheduler_bit[32] = {
+	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
+
+/**
+	@relates scheduler_s
+	@fn size_t scheduler_t__pass(uint32_t passes)
+	@brief Get the index of the first pass of a pass mask
+	@param passes Non zero pass mask
+	@return Pass index
+*/
+size_t scheduler_t__pass(uint32_t passes)
+{
+	return scheduler_bit[(uint32_t) ((passes & (~passes + 1)) * 0x077CB531UL) >> 27];
+}
+
+/**
+	@relates scheduler_s
+	@fn size_t scheduler_t__addPass(Scheduler_t *self, layer_t update, layer_t draw)
+	@brief Declare the next pass of the frame, passes run in declaration order
+	@param self Object pointer
+	@param update Layers updated by the pass
+	@param draw Layers drawn by the pass
+	@return Pass index, SCHEDULER_PASSES when every pass is taken
+*/
+size_t scheduler_t__addPass(Scheduler_t *self, layer_t update, layer_t draw)
+{
+	size_t	  i;
+	uint32_t	flag;
+	layer_t	 layer;
+	
+	if (self->scheduler.passes == SCHEDULER_PASSES)
+		return SCHEDULER_PASSES;
+	
+	self->scheduler.pass[self->scheduler.passes].update = update;
+	self->scheduler.pass[self->scheduler.passes].draw = draw;
+	flag = (uint32_t) 1 << self->scheduler.passes;
+	layer = update | draw;
+	
+	/* Passes of a layer are looked up one byte at a time */
+	for (i = 0; i < 256; ++i)
+	{
+		if (i & (layer & 0xFF))
+			self->scheduler.low[i] |= flag;
+		
+		if (i & (layer >> 8))
+			self->scheduler.high[i] |= flag;
+	}
+	
+	return self->scheduler.passes++;
+}
+
+/**
+	@relates scheduler_s
+	@fn void scheduler_t__run(Scheduler_t *self, CVector_t *vector)
+	@brief Update and draw the entities of a frame through every pass.
+	The layers are read once per entity and each entity is bucketed in the passes
+	selecting one of its layers, then each pass walks its own bucket
+	@param self Object pointer
+	@param vector Entities of the frame
+	@return void
+	
+	@note Within a pass entities keep the vector order. A layer changed by an update
+	is seen from the next frame on
+*/
+void scheduler_t__run(Scheduler_t *self, CVector_t *vector)
+{
+	size_t			   i, j;
+	size_t			   total;
+	uint32_t			 passes;
+	layer_t			  layer;
+	Entity_t			 *content = NULL;
+	scheduler_item_t	 *item = NULL;
+	scheduler_pass_t	 *pass = NULL;
+	
+	if (vector->cvector.count > self->scheduler.size)
+	{
+		while (self->scheduler.size < vector->cvector.count)
+			self->scheduler.size *= 2;
+		
+		self->scheduler.item = realloc(self->scheduler.item, self->scheduler.size * sizeof(scheduler_item_t));
+	}
+	
+	self->scheduler.count = vector->cvector.count;
+	
+	for (j = 0; j < self->scheduler.passes; ++j)
+		self->scheduler.pass[j].count = 0;
+	
+	for (i = 0; i < self->scheduler.count; ++i)
+	{
+		item = &(self->scheduler.item[i]);
+		item->content = vector->cvector.content[i];
+		item->layer = item->content->entity.vtable->getLayer(item->content);
+		item->passes = self->scheduler.low[item->layer & 0xFF] | self->scheduler.high[item->layer >> 8];
+		
+		/* Only the passes of the entity are walked, one set bit at a time */
+		for (passes = item->passes; passes; passes &= passes - 1)
+			self->scheduler.pass[scheduler_t__pass(passes)].count++;
+	}
+	
+	for (j = 0, total = 0; j < self->scheduler.passes; ++j)
+	{
+		self->scheduler.pass[j].start = total;
+		self->scheduler.pass[j].next = total;
+		total += self->scheduler.pass[j].count;
+	}
+	
+	if (total > self->scheduler.room)
+	{
+		while (self->scheduler.room < total)
+			self->scheduler.room *= 2;
+		
+		self->scheduler.entry = realloc(self->scheduler.entry, self->scheduler.room * sizeof(scheduler_item_t));
+	}
+	
+	for (i = 0; i < self->scheduler.count; ++i)
+	{
+		item = &(self->scheduler.item[i]);
+		
+		for (passes = item->passes; passes; passes &= passes - 1)
+		{
+			pass = &(self->scheduler.pass[scheduler_t__pass(passes)]);
+			self->scheduler.entry[pass->next++] = *item;
+		}
+	}
+	
+	self->scheduler.entries = total;
+	
+	for (j = 0; j < self->scheduler.passes; ++j)
+	{
+		pass = &(self->scheduler.pass[j]);
+		
+		for (i = pass->start; i < pass->start + pass->count; ++i)
+		{
+			content = self->scheduler.entry[i].content;
+			layer = self->scheduler.entry[i].layer;
+			
+			if (layer & pass->update)
+				content->entity.vtable->update(content);
+			
+			if (layer & pass->draw)
+				content->entity.vtable->draw(content);
+		}
+	}
+}
+
+static const scheduler_vtable_t scheduler_vtable = {
+	&scheduler_t__addPass,
+	&scheduler_t__run
+};
+
+retno_t scheduler_t__ctor(Scheduler_t *self)
+{
+	size_t i;
+	
+	for (i = 0; i < 256; ++i)
+	{
+		self->scheduler.low[i] = 0;
+		self->scheduler.high[i] = 0;
+	}
+	
+	self->scheduler.passes = 0;
+	self->scheduler.size = SCHEDULER_SIZE;
+	self->scheduler.room = SCHEDULER_SIZE;
+	self->scheduler.item = malloc(self->scheduler.size * sizeof(scheduler_item_t));
+	self->scheduler.entry = malloc(self->scheduler.room * sizeof(scheduler_item_t));
+	
+	self->scheduler.vtable = &scheduler_vtable;
+	
+	return SUCCESS;
+}
+
+retno_t scheduler_t__dtor(Scheduler_t *self)
+{
+	free(self->scheduler.item);
+	free(self->scheduler.entry);
+	
+	return SUCCESS;
+}
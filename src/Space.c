@@ -0,0 +1,450 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Space.c
+	@brief Methods shared by the spatial index backends, built on their visit
+*/
+
+#include <Base.h>
+#include <Batch.h>
+#include <CList.h>
+#include <CVector.h>
+#include <Entity.h>
+#include <math.h>
+#include <SDL2/SDL.h>
+#include <Space.h>
+#include <Window.h>
+
+/**
+	@relates space_s
+	@fn void space_t__collect(Entity_t *content, void *data)
+	@brief Visit callback pushing elements in a CList
+	@param content Element pointer
+	@param data CList pointer
+	@return void
+*/
+void space_t__collect(Entity_t *content, void *data)
+{
+	CList_t *list = NULL;
+	
+	list = data;
+	list->clist.vtable->push(list, content);
+}
+
+/**
+	@relates space_s
+	@fn CList_t *space_t__fetch(Space_t *self, SDL_FRect rect)
+	@brief Fetch elements in rect area
+	@param self Object pointer
+	@param rect Area
+	@return Chained list of elements
+*/
+CList_t *space_t__fetch(Space_t *self, SDL_FRect rect)
+{
+	return self->space.vtable->fetchLayer(self, rect, ALL_LAYER);
+}
+
+/**
+	@relates space_s
+	@fn CList_t *space_t__fetchLayer(Space_t *self, SDL_FRect rect, layer_t layer)
+	@brief Fetch elements of the layers in rect area
+	@param self Object pointer
+	@param rect Area
+	@param layer Layers mask
+	@return Chained list of elements
+*/
+CList_t *space_t__fetchLayer(Space_t *self, SDL_FRect rect, layer_t layer)
+{
+	CList_t *list = NULL;
+	
+	list = CList();
+	self->space.vtable->visit(self, rect, layer, &space_t__collect, list);
+	
+	return list;
+}
+
+/**
+	@relates space_s
+	@fn CList_t *space_t__fetchFrame(Space_t *self, SDL_FRect rect, layer_t layer, Window_t *window)
+	@brief Fetch elements of the layers in rect area in a list of the window frame arena
+	@param self Object pointer
+	@param rect Area
+	@param layer Layers mask
+	@param window Window owning the frame arena
+	@return Chained list of elements, valid until the window update
+*/
+CList_t *space_t__fetchFrame(Space_t *self, SDL_FRect rect, layer_t layer, Window_t *window)
+{
+	CList_t *list = NULL;
+	
+	list = window->window.vtable->frameList(window);
+	self->space.vtable->visit(self, rect, layer, &space_t__collect, list);
+	
+	return list;
+}
+
+/**
+	@relates space_s
+	@fn void space_t__store(Entity_t *content, void *data)
+	@brief Visit callback pushing elements in a CVector
+	@param content Element pointer
+	@param data CVector pointer
+	@return void
+*/
+void space_t__store(Entity_t *content, void *data)
+{
+	CVector_t *vector = NULL;
+	
+	vector = data;
+	vector->cvector.vtable->push(vector, content);
+}
+
+/**
+	@relates space_s
+	@fn void space_t__fetchVector(Space_t *self, SDL_FRect rect, layer_t layer, CVector_t *vector)
+	@brief Append the elements of the layers in rect area to a vector, nothing is allocated once it has grown
+	@param self Object pointer
+	@param rect Area
+	@param layer Layers mask
+	@param vector Destination, not emptied first
+	@return void
+*/
+void space_t__fetchVector(Space_t *self, SDL_FRect rect, layer_t layer, CVector_t *vector)
+{
+	self->space.vtable->visit(self, rect, layer, &space_t__store, vector);
+}
+
+/**
+	@relates space_s
+	@fn void space_t__gather(Entity_t *content, void *data)
+	@brief Visit callback recording elements for a batch query
+	@param content Element pointer
+	@param data Batch query pointer
+	@return void
+*/
+void space_t__gather(Entity_t *content, void *data)
+{
+	batch_query_t *query = NULL;
+	
+	query = data;
+	query->batch->batch.vtable->push(query->batch, query->query, content);
+}
+
+/**
+	@relates space_s
+	@fn void space_t__query(Space_t *self, Batch_t *batch)
+	@brief Answer every query of a batch with a visit of each area
+	@param self Object pointer
+	@param batch Batch pointer
+	@return void
+	
+	@note Used by the Grid and LTree, their cells and Morton ranges have no shared upper level
+	for the queries to open once
+*/
+void space_t__query(Space_t *self, Batch_t *batch)
+{
+	batch_query_t query;
+	
+	query.batch = batch;
+	
+	for (query.query = 0; query.query < batch->batch.count; ++query.query)
+		self->space.vtable->visit(self, batch->batch.rect[query.query], batch->batch.layer, &space_t__gather, &query);
+}
+
+/**
+	@relates space_s
+	@fn float space_t__distance(SDL_FRect rect, SDL_FPoint point)
+	@brief Get the squared distance from a point to a rect, zero when the point is inside
+	@param rect Area
+	@param point Point
+	@return Squared distance
+*/
+float space_t__distance(SDL_FRect rect, SDL_FPoint point)
+{
+	float dx, dy;
+	
+	dx = MAX(MAX(rect.x - point.x, point.x - (rect.x + rect.w)), 0);
+	dy = MAX(MAX(rect.y - point.y, point.y - (rect.y + rect.h)), 0);
+	
+	return dx * dx + dy * dy;
+}
+
+/**
+	@relates space_s
+	@fn uint8_t space_t__slab(SDL_FRect rect, SDL_FPoint from, SDL_FPoint move, float *enter, float *leave)
+	@brief Clip a segment against a rect one axis at a time
+	@param rect Area
+	@param from Segment start
+	@param move Segment direction and length
+	@param enter Receives the entry time, negative when from is inside
+	@param leave Receives the exit time
+	@return Boolean TRUE if the segment crosses the rect between times 0 and 1
+*/
+uint8_t space_t__slab(SDL_FRect rect, SDL_FPoint from, SDL_FPoint move, float *enter, float *leave)
+{
+	float low, high, swap;
+	
+	*enter = -1;
+	*leave = 2;
+	
+	if (move.x == 0)
+	{
+		if (from.x < rect.x || from.x > rect.x + rect.w)
+			return 0;
+	}
+	else
+	{
+		low = (rect.x - from.x) / move.x;
+		high = (rect.x + rect.w - from.x) / move.x;
+		if (low > high)
+		{
+			swap = low;
+			low = high;
+			high = swap;
+		}
+		*enter = MAX(*enter, low);
+		*leave = MIN(*leave, high);
+	}
+	
+	if (move.y == 0)
+	{
+		if (from.y < rect.y || from.y > rect.y + rect.h)
+			return 0;
+	}
+	else
+	{
+		low = (rect.y - from.y) / move.y;
+		high = (rect.y + rect.h - from.y) / move.y;
+		if (low > high)
+		{
+			swap = low;
+			low = high;
+			high = swap;
+		}
+		*enter = MAX(*enter, low);
+		*leave = MIN(*leave, high);
+	}
+	
+	return *enter <= *leave && *leave >= 0 && *enter <= 1;
+}
+
+/**
+	@relates space_s
+	@fn void space_t__move(Space_t *self, Entity_t *content, SDL_FPoint from)
+	@brief Re-home a moved element by removing it and inserting it again
+	@param self Object pointer
+	@param content Element pointer
+	@param from Element position before it moved, unused
+	@return void
+	
+	@note Elements of the static index of a Split end in its dynamic one
+*/
+void space_t__move(Space_t *self, Entity_t *content, SDL_FPoint from)
+{
+	if (self->space.vtable->remove(self, content))
+		self->space.vtable->insert(self, content);
+}
+
+/**
+	@relates space_s
+	@fn void space_t__circle(Entity_t *content, void *data)
+	@brief Visit callback passing on the elements whose hitbox touches a circle
+	@param content Element pointer
+	@param data space_circle_t pointer
+	@return void
+*/
+void space_t__circle(Entity_t *content, void *data)
+{
+	space_circle_t *circle = NULL;
+	
+	circle = data;
+	
+	if (space_t__distance(content->entity.vtable->getHitbox(content), circle->center) <= circle->limit)
+		circle->callback(content, circle->data);
+}
+
+/**
+	@relates space_s
+	@fn void space_t__visitCircle(Space_t *self, SDL_FPoint center, float radius, layer_t layer, space_visit_t callback, void *data)
+	@brief Call back every element of the layers whose hitbox touches the circle,
+	through a visit of its bounding square grown by one unit, so hitboxes touching it are seen
+	@param self Object pointer
+	@param center Circle center
+	@param radius Circle radius
+	@param layer Layers mask
+	@param callback Function called with each element and data
+	@param data User pointer given to callback
+	@return void
+*/
+void space_t__visitCircle(Space_t *self, SDL_FPoint center, float radius, layer_t layer, space_visit_t callback, void *data)
+{
+	SDL_FRect		 rect;
+	space_circle_t	circle;
+	
+	rect.x = center.x - radius - 1;
+	rect.y = center.y - radius - 1;
+	rect.w = 2 * radius + 2;
+	rect.h = 2 * radius + 2;
+	circle.center = center;
+	circle.limit = radius * radius;
+	circle.callback = callback;
+	circle.data = data;
+	
+	self->space.vtable->visit(self, rect, layer, &space_t__circle, &circle);
+}
+
+/**
+	@relates space_s
+	@fn void space_t__near(Entity_t *content, void *data)
+	@brief Visit callback inserting the elements within reach in the sorted result
+	@param content Element pointer
+	@param data space_near_t pointer
+	@return void
+*/
+void space_t__near(Entity_t *content, void *data)
+{
+	size_t		   i;
+	float			distance;
+	space_near_t	 *near = NULL;
+	
+	near = data;
+	distance = space_t__distance(content->entity.vtable->getHitbox(content), near->point);
+	
+	if (distance > near->limit)
+		return;
+	
+	i = near->found < near->count ? near->found++ : near->count;
+	
+	for (; i > 0; --i)
+	{
+		if (space_t__distance(near->result[i - 1]->entity.vtable->getHitbox(near->result[i - 1]), near->point) <= distance)
+			break;
+		
+		if (i < near->count)
+			near->result[i] = near->result[i - 1];
+	}
+	
+	if (i < near->count)
+		near->result[i] = content;
+}
+
+/**
+	@relates space_s
+	@fn size_t space_t__nearest(Space_t *self, SDL_FPoint point, layer_t layer, Entity_t **result, size_t count)
+	@brief Find the elements of the layers nearest to a point, measured to their hitbox.
+	Squares around the point are visited, doubling from SPACE_STEP, until count elements lie
+	within the square half size
+	@param self Object pointer
+	@param point Query point
+	@param layer Layers mask
+	@param result Array receiving up to count elements, nearest first
+	@param count Number of elements wanted
+	@return Number of elements written in result
+	
+	@note Elements farther than SPACE_REACH are not found
+*/
+size_t space_t__nearest(Space_t *self, SDL_FPoint point, layer_t layer, Entity_t **result, size_t count)
+{
+	float			reach;
+	SDL_FRect		rect;
+	space_near_t	 near;
+	
+	near.point = point;
+	near.result = result;
+	near.count = count;
+	near.found = 0;
+	
+	for (reach = SPACE_STEP; count && reach <= SPACE_REACH; reach *= 2)
+	{
+		rect.x = point.x - reach - 1;
+		rect.y = point.y - reach - 1;
+		rect.w = 2 * reach + 2;
+		rect.h = 2 * reach + 2;
+		near.limit = reach * reach;
+		near.found = 0;
+		
+		self->space.vtable->visit(self, rect, layer, &space_t__near, &near);
+		
+		if (near.found == count)
+			break;
+	}
+	
+	return near.found;
+}
+
+/**
+	@relates space_s
+	@fn void space_t__ray(Entity_t *content, void *data)
+	@brief Visit callback keeping the nearest element hit by a ray
+	@param content Element pointer
+	@param data space_ray_t pointer
+	@return void
+*/
+void space_t__ray(Entity_t *content, void *data)
+{
+	float			enter, leave;
+	space_ray_t	  *ray = NULL;
+	
+	ray = data;
+	
+	if (space_t__slab(content->entity.vtable->getHitbox(content), ray->from, ray->move, &enter, &leave) &&
+		enter >= 0 && enter < ray->time)
+	{
+		ray->time = enter;
+		ray->hit = content;
+	}
+}
+
+/**
+	@relates space_s
+	@fn Entity_t *space_t__raycast(Space_t *self, SDL_FPoint from, SDL_FPoint to, layer_t layer, float *time)
+	@brief Find the first element of the layers hit by the segment from-to,
+	through a visit of the segment bounding box grown by one unit
+	@param self Object pointer
+	@param from Segment start
+	@param to Segment end
+	@param layer Layers mask
+	@param time Receives the hit time between 0 and 1 along the segment, may be NULL
+	@return Element hit or NULL
+	
+	@note Hitboxes holding from are ignored so a ray cast from an element does not hit it
+*/
+Entity_t *space_t__raycast(Space_t *self, SDL_FPoint from, SDL_FPoint to, layer_t layer, float *time)
+{
+	SDL_FRect		rect;
+	space_ray_t	  ray;
+	
+	ray.from = from;
+	ray.move.x = to.x - from.x;
+	ray.move.y = to.y - from.y;
+	ray.layer = layer;
+	ray.time = 1;
+	ray.hit = NULL;
+	rect.x = MIN(from.x, to.x) - 1;
+	rect.y = MIN(from.y, to.y) - 1;
+	rect.w = fabs(ray.move.x) + 2;
+	rect.h = fabs(ray.move.y) + 2;
+	
+	self->space.vtable->visit(self, rect, layer, &space_t__ray, &ray);
+	
+	if (time)
+		*time = ray.time;
+	
+	return ray.hit;
+}
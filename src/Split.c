@@ -0,0 +1,229 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Split.c
+*/
+
+#include <Base.h>
+#include <Entity.h>
+#include <SDL2/SDL.h>
+#include <Space.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <Window.h>
+
+/**
+	@relates split_s
+	@fn void split_t__insert(Split_t *self, Entity_t *content)
+	@brief Insert element in the dynamic index
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+*/
+void split_t__insert(Split_t *self, Entity_t *content)
+{
+	if (!content->entity.vtable->getSpace(content))
+		content->entity.vtable->setSpace(content, self);
+	
+	self->split.dynamic->space.vtable->insert(self->split.dynamic, content);
+}
+
+/**
+	@relates split_s
+	@fn void split_t__build(Split_t *self, Entity_t **content, size_t count)
+	@brief Insert an elements array in the static index, built once
+	@param self Object pointer
+	@param content Elements array
+	@param count Elements count
+	@return void
+*/
+void split_t__build(Split_t *self, Entity_t **content, size_t count)
+{
+	size_t i;
+	
+	for (i = 0; i < count; ++i)
+	{
+		if (!content[i]->entity.vtable->getSpace(content[i]))
+			content[i]->entity.vtable->setSpace(content[i], self);
+	}
+	
+	self->split.fixed->space.vtable->build(self->split.fixed, content, count);
+}
+
+/**
+	@relates split_s
+	@fn uint8_t split_t__remove(Split_t *self, Entity_t *content)
+	@brief Remove element from the index holding it
+	@param self Object pointer
+	@param content Element pointer
+	@return Boolean TRUE if the element was in one of the indexes
+*/
+uint8_t split_t__remove(Split_t *self, Entity_t *content)
+{
+	return self->split.dynamic->space.vtable->remove(self->split.dynamic, content) ||
+		self->split.fixed->space.vtable->remove(self->split.fixed, content);
+}
+
+/**
+	@relates split_s
+	@fn uint8_t split_t__holds(Space_t *index, Entity_t *content)
+	@brief Tell whether an element sits in an index, through the root of its quadtree leaf
+	@param index Index pointer
+	@param content Element pointer
+	@return Boolean TRUE if the element is in index
+*/
+uint8_t split_t__holds(Space_t *index, Entity_t *content)
+{
+	Space_t *leaf = NULL;
+	
+	leaf = content->entity.vtable->getNode(content).leaf;
+	
+	if (leaf && leaf->type == QTREE)
+		leaf = leaf->qtree.pool->root;
+	
+	return leaf && leaf == index;
+}
+
+/**
+	@relates split_s
+	@fn void split_t__mark(Split_t *self, Entity_t *content)
+	@brief Record a moved element, a static element moves to the dynamic index first
+	@param self Object pointer
+	@param content Element pointer
+	@return void
+	
+	@note The element is flagged dirty before it reaches the static index dirty set, it is cleaned
+	while leaving the static index and dirty again once in the dynamic one
+*/
+void split_t__mark(Split_t *self, Entity_t *content)
+{
+	if (split_t__holds(self->split.fixed, content))
+	{
+		content->entity.vtable->setDirty(content, 0);
+		self->split.fixed->space.vtable->remove(self->split.fixed, content);
+		self->split.vtable->insert(self, content);
+		content->entity.vtable->setDirty(content, 1);
+	}
+	
+	self->split.dynamic->space.vtable->mark(self->split.dynamic, content);
+}
+
+/**
+	@relates split_s
+	@fn void split_t__update(Split_t *self)
+	@brief Update both indexes, the static one only changes when elements left it
+	@param self Object pointer
+	@return void
+*/
+void split_t__update(Split_t *self)
+{
+	self->split.fixed->space.vtable->update(self->split.fixed);
+	self->split.dynamic->space.vtable->update(self->split.dynamic);
+}
+
+/**
+	@relates split_s
+	@fn void split_t__visit(Split_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data)
+	@brief Call back every element of the layers in rect area from both indexes
+	@param self Object pointer
+	@param rect Area
+	@param layer Layers mask
+	@param callback Function called with each element and data
+	@param data User pointer given to callback
+	@return void
+*/
+void split_t__visit(Split_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data)
+{
+	self->split.fixed->space.vtable->visit(self->split.fixed, rect, layer, callback, data);
+	self->split.dynamic->space.vtable->visit(self->split.dynamic, rect, layer, callback, data);
+}
+
+/**
+	@relates split_s
+	@fn void split_t__query(Split_t *self, Batch_t *batch)
+	@brief Answer every query of a batch from both indexes
+	@param self Object pointer
+	@param batch Batch pointer
+	@return void
+*/
+void split_t__query(Split_t *self, Batch_t *batch)
+{
+	self->split.fixed->space.vtable->query(self->split.fixed, batch);
+	self->split.dynamic->space.vtable->query(self->split.dynamic, batch);
+}
+
+/**
+	@relates split_s
+	@fn void split_t__draw(Split_t *self, Window_t *window)
+	@brief Draw both indexes
+	@param self Object pointer
+	@param window Window pointer
+	@return void
+	
+	@warning Use it only for debugging
+*/
+void split_t__draw(Split_t *self, Window_t *window)
+{
+	self->split.fixed->space.vtable->draw(self->split.fixed, window);
+	self->split.dynamic->space.vtable->draw(self->split.dynamic, window);
+}
+
+static const space_vtable_t split_vtable = {
+	&split_t__update,
+	&split_t__draw,
+	&split_t__insert,
+	&split_t__build,
+	&split_t__mark,
+	&split_t__visit,
+	&space_t__fetch,
+	&space_t__fetchLayer,
+	&split_t__query,
+	&space_t__fetchVector,
+	&space_t__fetchFrame,
+	&split_t__remove,
+	&space_t__move,
+	&space_t__visitCircle,
+	&space_t__nearest,
+	&space_t__raycast
+};
+
+retno_t split_t__ctor(Split_t *self)
+{
+	if (!self->split.fixed || !self->split.dynamic)
+		return FAILURE;
+	
+	/* Entities query with their hitbox only if both indexes place them by hitbox */
+	self->split.loose = self->split.fixed->space.loose && self->split.dynamic->space.loose;
+	
+	self->split.vtable = &split_vtable;
+	
+	return SUCCESS;
+}
+
+retno_t split_t__dtor(Split_t *self)
+{
+	if (self->split.fixed)
+		delete(self->split.fixed);
+	
+	if (self->split.dynamic)
+		delete(self->split.dynamic);
+	
+	return SUCCESS;
+}
@@ -0,0 +1,376 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Sweep.c
+*/
+
+#include <Base.h>
+#include <CList.h>
+#include <CVector.h>
+#include <Entity.h>
+#include <SDL2/SDL.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Sweep.h>
+#include <Window.h>
+
+/* Runs of every sweep share one generation, entities compare their contacts with it without a sweep pointer */
+static size_t sweep_clock = 0;
+
+/**
+	@relates sweep_s
+	@fn size_t sweep_t__clock(void)
+	@brief Get the generation of the last sweep run
+	@return Run generation, 0 before the first run
+*/
+size_t sweep_t__clock(void)
+{
+	return sweep_clock;
+}
+
+/**
+	@relates sweep_s
+	@fn void sweep_t__expire(void)
+	@brief Start a new generation, the contacts of the last run become stale
+	@return void
+	
+	@warning The generation is shared without locking, sweeps and entities must stay on one thread
+*/
+void sweep_t__expire(void)
+{
+	sweep_clock++;
+}
+
+/**
+	@relates sweep_s
+	@fn uint32_t sweep_t__key(float value)
+	@brief Map a float on an unsigned key of the same order
+	@param value Float value
+	@return Sort key
+*/
+uint32_t sweep_t__key(float value)
+{
+	uint32_t bits;
+	
+	memcpy(&bits, &value, sizeof(bits));
+	
+	return bits & 0x80000000 ? ~bits : bits | 0x80000000;
+}
+
+/**
+	@relates sweep_s
+	@fn void sweep_t__sort(Sweep_t *self)
+	@brief Sort the boxes by their left side with a byte wise radix sort
+	@param self Object pointer
+	@return void
+	
+	@note Passes where every box shares the same byte are skipped
+*/
+void sweep_t__sort(Sweep_t *self)
+{
+	size_t		  i;
+	size_t		  shift;
+	size_t		  count[256];
+	size_t		  offset;
+	size_t		  total;
+	sweep_box_t	 *swap = NULL;
+	
+	for (shift = 0; shift < 32 && self->sweep.count; shift += 8)
+	{
+		memset(count, 0, sizeof(count));
+		
+		for (i = 0; i < self->sweep.count; ++i)
+			count[(self->sweep.box[i].key >> shift) & 0xFF]++;
+		
+		if (count[(self->sweep.box[0].key >> shift) & 0xFF] == self->sweep.count)
+			continue;
+		
+		for (i = 0, offset = 0; i < 256; ++i)
+		{
+			total = count[i];
+			count[i] = offset;
+			offset += total;
+		}
+		
+		for (i = 0; i < self->sweep.count; ++i)
+			self->sweep.spare[count[(self->sweep.box[i].key >> shift) & 0xFF]++] = self->sweep.box[i];
+		
+		swap = self->sweep.box;
+		self->sweep.box = self->sweep.spare;
+		self->sweep.spare = swap;
+	}
+}
+
+/**
+	@relates sweep_s
+	@fn void sweep_t__pair(Sweep_t *self, size_t mover, Entity_t *other)
+	@brief Record a contact of a mover box
+	@param self Object pointer
+	@param mover Mover box index
+	@param other Other element
+	@return void
+*/
+void sweep_t__pair(Sweep_t *self, size_t mover, Entity_t *other)
+{
+	if (self->sweep.pairs == self->sweep.room)
+	{
+		self->sweep.room *= 2;
+		self->sweep.pair = realloc(self->sweep.pair, self->sweep.room * sizeof(sweep_pair_t));
+		self->sweep.contact = realloc(self->sweep.contact, self->sweep.room * sizeof(Entity_t *));
+	}
+	
+	self->sweep.pair[self->sweep.pairs].mover = mover;
+	self->sweep.pair[self->sweep.pairs++].other = other;
+	self->sweep.box[mover].count++;
+}
+
+/**
+	@relates sweep_s
+	@fn size_t sweep_t__test(Sweep_t *self, size_t index, size_t *active, size_t count)
+	@brief Pair a box entering the sweep with an active list, boxes the sweep went past leave the list
+	@param self Object pointer
+	@param index Entering box index
+	@param active Active list
+	@param count Active list count
+	@return New active list count
+*/
+size_t sweep_t__test(Sweep_t *self, size_t index, size_t *active, size_t count)
+{
+	size_t			i = 0;
+	sweep_box_t	   *box = NULL;
+	sweep_box_t	   *other = NULL;
+	
+	box = &(self->sweep.box[index]);
+	
+	while (i < count)
+	{
+		other = &(self->sweep.box[active[i]]);
+		
+		if (other->rect.x + other->rect.w <= box->rect.x)
+		{
+			active[i] = active[--count];
+			continue;
+		}
+		
+		if (box->layer & other->layer &&
+			other->rect.y < box->rect.y + box->rect.h &&
+			box->rect.y < other->rect.y + other->rect.h)
+		{
+			if (box->mover)
+				sweep_t__pair(self, index, other->content);
+			
+			if (other->mover)
+				sweep_t__pair(self, active[i], box->content);
+		}
+		
+		++i;
+	}
+	
+	return count;
+}
+
+/**
+	@relates sweep_s
+	@fn void sweep_t__add(Sweep_t *self, Entity_t *content, float reach, layer_t movers)
+	@brief Append the box of an entity, movers boxes grow by reach on each side
+	@param self Object pointer
+	@param content Entity pointer
+	@param reach Farthest move of the frame
+	@param movers Layers of the entities to update
+	@return void
+*/
+void sweep_t__add(Sweep_t *self, Entity_t *content, float reach, layer_t movers)
+{
+	sweep_box_t *box = NULL;
+	
+	if (self->sweep.count == self->sweep.size)
+	{
+		self->sweep.size *= 2;
+		self->sweep.box = realloc(self->sweep.box, self->sweep.size * sizeof(sweep_box_t));
+		self->sweep.spare = realloc(self->sweep.spare, self->sweep.size * sizeof(sweep_box_t));
+		self->sweep.moving = realloc(self->sweep.moving, self->sweep.size * sizeof(size_t));
+		self->sweep.still = realloc(self->sweep.still, self->sweep.size * sizeof(size_t));
+	}
+	
+	box = &(self->sweep.box[self->sweep.count++]);
+	box->content = content;
+	content->entity.vtable->setContacts(content, self->sweep.runs, NULL, 0);
+	box->rect = content->entity.vtable->getHitbox(content);
+	box->layer = content->entity.vtable->getLayer(content);
+	box->mover = (box->layer & movers) != 0;
+	box->count = 0;
+	
+	if (box->mover)
+	{
+		box->rect.x -= reach;
+		box->rect.y -= reach;
+		box->rect.w += 2 * reach;
+		box->rect.h += 2 * reach;
+	}
+	
+	box->key = sweep_t__key(box->rect.x);
+}
+
+/**
+	@relates sweep_s
+	@fn size_t sweep_t__solve(Sweep_t *self)
+	@brief Sort and sweep the boxes, then give each mover its contacts
+	@param self Object pointer
+	@return Contacts count
+*/
+size_t sweep_t__solve(Sweep_t *self)
+{
+	size_t			i, j;
+	size_t			offset;
+	size_t			moving = 0;
+	size_t			still = 0;
+	sweep_box_t	   *box = NULL;
+	
+	sweep_t__sort(self);
+	
+	for (i = 0; i < self->sweep.count; ++i)
+	{
+		moving = sweep_t__test(self, i, self->sweep.moving, moving);
+		
+		if (self->sweep.box[i].mover)
+		{
+			still = sweep_t__test(self, i, self->sweep.still, still);
+			self->sweep.moving[moving++] = i;
+		} else
+			self->sweep.still[still++] = i;
+	}
+	
+	/* Contacts are grouped by mover so each one reads a single span */
+	for (i = 0, offset = 0; i < self->sweep.count; ++i)
+	{
+		box = &(self->sweep.box[i]);
+		
+		if (box->mover)
+			box->content->entity.vtable->setContacts(box->content, self->sweep.runs, self->sweep.contact + offset, box->count);
+		
+		j = box->count;
+		box->count = offset;
+		offset += j;
+	}
+	
+	for (i = 0; i < self->sweep.pairs; ++i)
+		self->sweep.contact[self->sweep.box[self->sweep.pair[i].mover].count++] = self->sweep.pair[i].other;
+	
+	return self->sweep.pairs;
+}
+
+/**
+	@relates sweep_s
+	@fn size_t sweep_t__run(Sweep_t *self, CList_t *list, layer_t movers)
+	@brief Find every overlapping (mover, other) pair of a list in one sort and sweep,
+	each mover gets its contacts to test in its next update
+	@param self Object pointer
+	@param list Entities of the frame
+	@param movers Layers of the entities to update
+	@return Contacts count
+	
+	@note Movers boxes grow by the farthest move of the frame.
+	Only entities sharing a layer make a pair, like in a space query.
+	Still boxes are only tested against movers.
+	@note Contacts point in the sweep, they are valid until the next run of any sweep.
+	Deleting an entity of the run drops the contacts of the run,
+	movers query their space instead.
+*/
+size_t sweep_t__run(Sweep_t *self, CList_t *list, layer_t movers)
+{
+	float			 reach;
+	Entity_t		  *content = NULL;
+	clist_block_t	 *block = NULL;
+	
+	reach = ENTITYSPEED * ENTITYBOOST * self->sweep.window->window.vtable->getDeltatime(self->sweep.window);
+	self->sweep.count = 0;
+	self->sweep.pairs = 0;
+	sweep_t__expire();
+	self->sweep.runs = sweep_t__clock();
+	
+	content = list->clist.vtable->iter(list, &block);
+	while (content)
+	{
+		sweep_t__add(self, content, reach, movers);
+		content = list->clist.vtable->iter(list, &block);
+	}
+	
+	return sweep_t__solve(self);
+}
+
+/**
+	@relates sweep_s
+	@fn size_t sweep_t__runVector(Sweep_t *self, CVector_t *vector, layer_t movers)
+	@brief Same as run on the entities of a vector
+	@param self Object pointer
+	@param vector Entities of the frame
+	@param movers Layers of the entities to update
+	@return Contacts count
+*/
+size_t sweep_t__runVector(Sweep_t *self, CVector_t *vector, layer_t movers)
+{
+	size_t	i;
+	float	 reach;
+	
+	reach = ENTITYSPEED * ENTITYBOOST * self->sweep.window->window.vtable->getDeltatime(self->sweep.window);
+	self->sweep.count = 0;
+	self->sweep.pairs = 0;
+	sweep_t__expire();
+	self->sweep.runs = sweep_t__clock();
+	
+	for (i = 0; i < vector->cvector.count; ++i)
+		sweep_t__add(self, vector->cvector.content[i], reach, movers);
+	
+	return sweep_t__solve(self);
+}
+
+static const sweep_vtable_t sweep_vtable = {
+	&sweep_t__run,
+	&sweep_t__runVector
+};
+
+retno_t sweep_t__ctor(Sweep_t *self)
+{
+	self->sweep.size = SWEEP_SIZE;
+	self->sweep.room = SWEEP_SIZE;
+	self->sweep.box = malloc(self->sweep.size * sizeof(sweep_box_t));
+	self->sweep.spare = malloc(self->sweep.size * sizeof(sweep_box_t));
+	self->sweep.pair = malloc(self->sweep.room * sizeof(sweep_pair_t));
+	self->sweep.contact = malloc(self->sweep.room * sizeof(Entity_t *));
+	self->sweep.moving = malloc(self->sweep.size * sizeof(size_t));
+	self->sweep.still = malloc(self->sweep.size * sizeof(size_t));
+	
+	self->sweep.vtable = &sweep_vtable;
+	
+	return SUCCESS;
+}
+
+retno_t sweep_t__dtor(Sweep_t *self)
+{
+	free(self->sweep.box);
+	free(self->sweep.spare);
+	free(self->sweep.pair);
+	free(self->sweep.contact);
+	free(self->sweep.moving);
+	free(self->sweep.still);
+	
+	return SUCCESS;
+}
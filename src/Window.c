@@ -21,12 +21,356 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
 #include <Base.h>
+#include <CList.h>
 #include <Entity.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <Window.h>
 
+/**
+	@relates window_s
+	@fn window_atlas_t *window_t__pack(Window_t *self, SDL_Rect *rect)
+	@brief Reserve a rect in the atlas, a new page is opened when the current one is full
+	@param self Object pointer
+	@param rect Rect size to reserve, its position is set to the reserved place
+	@return Atlas page holding the rect
+*/
+window_atlas_t *window_t__pack(Window_t *self, SDL_Rect *rect)
+{
+	clist_block_t	*block = NULL;
+	window_atlas_t   *atlas = NULL;
+	
+	atlas = self->window.atlas->clist.vtable->iter(self->window.atlas, &block);
+	
+	if (atlas && atlas->x + rect->w > atlas->width)
+	{
+		atlas->x = 0;
+		atlas->y += atlas->shelf;
+		atlas->shelf = 0;
+	}
+	
+	if (!atlas ||
+		atlas->x + rect->w > atlas->width ||
+		atlas->y + rect->h > atlas->height)
+	{
+		atlas = calloc(1, sizeof(window_atlas_t));
+		atlas->width = MAX(WINDOW_ATLAS, rect->w);
+		atlas->height = MAX(WINDOW_ATLAS, rect->h);
+		atlas->texture = SDL_CreateTexture(
+			self->window.renderer,
+			SDL_PIXELFORMAT_RGBA32,
+			SDL_TEXTUREACCESS_STATIC,
+			atlas->width,
+			atlas->height
+		);
+		LOG_ERROR(!atlas->texture, SDL_GetError());
+		SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+		
+		self->window.atlas->clist.vtable->push(self->window.atlas, atlas);
+	}
+	
+	rect->x = atlas->x;
+	rect->y = atlas->y;
+	atlas->x += rect->w;
+	atlas->shelf = MAX(atlas->shelf, rect->h);
+	
+	return atlas;
+}
+
+/**
+	@relates window_s
+	@fn SDL_Surface *window_t__extrude(SDL_Surface *surface)
+	@brief Copy an RGBA32 image in a surface larger by WINDOW_GUTTER on each side,
+	the gutter repeats the image edges
+	@param surface RGBA32 image
+	@return New surface or NULL on failure
+	
+	@note Filtering or a sub-texel offset at an image edge samples its own gutter
+	instead of the next image of the atlas
+*/
+SDL_Surface *window_t__extrude(SDL_Surface *surface)
+{
+	int			 x, y;
+	Uint32		  *row = NULL;
+	Uint32		  *source = NULL;
+	SDL_Surface	 *padded = NULL;
+	
+	padded = SDL_CreateRGBSurfaceWithFormat(
+		0,
+		surface->w + 2 * WINDOW_GUTTER,
+		surface->h + 2 * WINDOW_GUTTER,
+		32,
+		SDL_PIXELFORMAT_RGBA32
+	);
+	if (!padded)
+		return NULL;
+	
+	for (y = 0; y < padded->h; ++y)
+	{
+		row = (Uint32 *) ((Uint8 *) padded->pixels + y * padded->pitch);
+		source = (Uint32 *) ((Uint8 *) surface->pixels +
+			MIN(MAX(y - WINDOW_GUTTER, 0), surface->h - 1) * surface->pitch);
+		
+		for (x = 0; x < padded->w; ++x)
+			row[x] = source[MIN(MAX(x - WINDOW_GUTTER, 0), surface->w - 1)];
+	}
+	
+	return padded;
+}
+
+/**
+	@relates window_s
+	@fn window_texture_t *window_t__takeTexture(Window_t *self, char *path)
+	@brief Take a shared texture handle, packing the image in the atlas on first use
+	@param self Object pointer
+	@param path Image path
+	@return Texture handle or NULL if the image can't be loaded
+	
+	@note Every handle taken must be given back with releaseTexture.
+	Images are packed with an extruded gutter of WINDOW_GUTTER pixels.
+*/
+window_texture_t *window_t__takeTexture(Window_t *self, char *path)
+{
+	int					retno;
+	SDL_Surface			*image = NULL;
+	SDL_Surface			*surface = NULL;
+	SDL_Surface			*padded = NULL;
+	clist_block_t		  *block = NULL;
+	window_atlas_t		 *atlas = NULL;
+	window_texture_t	   *texture = NULL;
+	
+	texture = self->window.textures->clist.vtable->iter(self->window.textures, &block);
+	while (texture)
+	{
+		if (!strcmp(texture->path, path))
+		{
+			texture->count++;
+			return texture;
+		}
+		
+		texture = self->window.textures->clist.vtable->iter(self->window.textures, &block);
+	}
+	
+	image = IMG_Load(path);
+	if (!image)
+	{
+		LOG_ERROR(1, SDL_GetError());
+		return NULL;
+	}
+	
+	surface = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+	SDL_FreeSurface(image);
+	if (!surface)
+	{
+		LOG_ERROR(1, SDL_GetError());
+		return NULL;
+	}
+	
+	padded = window_t__extrude(surface);
+	SDL_FreeSurface(surface);
+	if (!padded)
+	{
+		LOG_ERROR(1, SDL_GetError());
+		return NULL;
+	}
+	
+	texture = calloc(1, sizeof(window_texture_t));
+	texture->rect.w = padded->w;
+	texture->rect.h = padded->h;
+	atlas = window_t__pack(self, &(texture->rect));
+	
+	retno = SDL_UpdateTexture(
+		atlas->texture,
+		&(texture->rect),
+		padded->pixels,
+		padded->pitch
+	);
+	LOG_ERROR(retno, SDL_GetError());
+	SDL_FreeSurface(padded);
+	
+	/* The handle clips the image inside its gutter */
+	texture->rect.x += WINDOW_GUTTER;
+	texture->rect.y += WINDOW_GUTTER;
+	texture->rect.w -= 2 * WINDOW_GUTTER;
+	texture->rect.h -= 2 * WINDOW_GUTTER;
+	
+	texture->path = malloc(strlen(path) + 1);
+	strcpy(texture->path, path);
+	texture->count = 1;
+	texture->width = texture->rect.w;
+	texture->height = texture->rect.h;
+	texture->texture = atlas->texture;
+	
+	self->window.textures->clist.vtable->attach(self->window.textures, &(texture->link), texture);
+	
+	return texture;
+}
+
+/**
+	@relates window_s
+	@fn void window_t__releaseTexture(Window_t *self, window_texture_t *texture)
+	@brief Give back a texture handle, the handle is freed with its last reference
+	@param self Object pointer
+	@param texture Texture handle
+	@return void
+	
+	@note The atlas space is not reclaimed, it stays until the Window is deleted
+*/
+void window_t__releaseTexture(Window_t *self, window_texture_t *texture)
+{
+	if (!texture || --texture->count)
+		return;
+	
+	self->window.textures->clist.vtable->unlink(self->window.textures, &(texture->link));
+	
+	free(texture->path);
+	free(texture);
+}
+
+/**
+	@relates window_s
+	@fn void window_t__queue(window_pass_t *pass, SDL_Texture *texture, SDL_Rect *clip, SDL_FRect *rect)
+	@brief Queue a textured quad in a render pass
+	@param pass Render pass
+	@param texture Source texture
+	@param clip Source rect or NULL for the whole texture
+	@param rect Destination rect
+	@return void
+	
+	@note Consecutive quads sharing a texture go in the same batch
+*/
+void window_t__queue(window_pass_t *pass, SDL_Texture *texture, SDL_Rect *clip, SDL_FRect *rect)
+{
+	int				i;
+	int				width;
+	int				height;
+	SDL_Rect		   source;
+	SDL_Vertex		 *vertex = NULL;
+	window_batch_t	 *batch = NULL;
+	
+	if (!texture)
+		return;
+	
+	if (pass->count)
+		batch = &(pass->batch[pass->count - 1]);
+	
+	if (!batch || batch->texture != texture)
+	{
+		if (pass->count == pass->size)
+		{
+			pass->size = pass->size ? 2 * pass->size : 4;
+			pass->batch = realloc(pass->batch, pass->size * sizeof(window_batch_t));
+			memset(
+				pass->batch + pass->count,
+				0,
+				(pass->size - pass->count) * sizeof(window_batch_t)
+			);
+		}
+		
+		SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+		batch = &(pass->batch[pass->count++]);
+		batch->count = 0;
+		batch->width = width;
+		batch->height = height;
+		batch->texture = texture;
+	}
+	
+	if (batch->count == batch->size)
+	{
+		batch->size = batch->size ? 2 * batch->size : WINDOW_BATCH;
+		batch->vertices = realloc(batch->vertices, 4 * batch->size * sizeof(SDL_Vertex));
+		batch->indices = realloc(batch->indices, 6 * batch->size * sizeof(int));
+		
+		for (i = batch->count; i < batch->size; ++i)
+		{
+			batch->indices[6 * i + 0] = 4 * i + 0;
+			batch->indices[6 * i + 1] = 4 * i + 1;
+			batch->indices[6 * i + 2] = 4 * i + 2;
+			batch->indices[6 * i + 3] = 4 * i + 2;
+			batch->indices[6 * i + 4] = 4 * i + 3;
+			batch->indices[6 * i + 5] = 4 * i + 0;
+		}
+	}
+	
+	if (clip)
+		source = *clip;
+	else
+	{
+		source.x = 0;
+		source.y = 0;
+		source.w = batch->width;
+		source.h = batch->height;
+	}
+	
+	vertex = &(batch->vertices[4 * batch->count++]);
+	
+	for (i = 0; i < 4; ++i)
+	{
+		vertex[i].position.x = rect->x + ((i + 1) / 2 % 2) * rect->w;
+		vertex[i].position.y = rect->y + (i / 2) * rect->h;
+		vertex[i].tex_coord.x = (source.x + ((i + 1) / 2 % 2) * source.w) / batch->width;
+		vertex[i].tex_coord.y = (source.y + (i / 2) * source.h) / batch->height;
+		vertex[i].color.r = 255;
+		vertex[i].color.g = 255;
+		vertex[i].color.b = 255;
+		vertex[i].color.a = 255;
+	}
+}
+
+/**
+	@relates window_s
+	@fn void window_t__flush(Window_t *self, window_pass_t *pass, SDL_Texture *target)
+	@brief Render all queued batches of a pass on a target
+	@param self Object pointer
+	@param pass Render pass
+	@param target Render target
+	@return void
+*/
+void window_t__flush(Window_t *self, window_pass_t *pass, SDL_Texture *target)
+{
+	size_t			 i;
+	window_batch_t	 *batch = NULL;
+#ifdef DEBUG_BOX
+	int				j;
+	SDL_FRect		  rect;
+#endif
+	
+	SDL_SetRenderTarget(self->window.renderer, target);
+	
+	for (i = 0; i < pass->count; ++i)
+	{
+		batch = &(pass->batch[i]);
+		
+		SDL_RenderGeometry(
+			self->window.renderer,
+			batch->texture,
+			batch->vertices,
+			4 * batch->count,
+			batch->indices,
+			6 * batch->count
+		);
+		self->window.drawcalls++;
+		
+#ifdef DEBUG_BOX
+		SDL_SetRenderDrawColor(self->window.renderer, 0, 255, 0, 255);
+		
+		for (j = 0; j < batch->count; ++j)
+		{
+			rect.x = batch->vertices[4 * j].position.x;
+			rect.y = batch->vertices[4 * j].position.y;
+			rect.w = batch->vertices[4 * j + 2].position.x - rect.x;
+			rect.h = batch->vertices[4 * j + 2].position.y - rect.y;
+			SDL_RenderDrawRectF(self->window.renderer, &rect);
+		}
+#endif
+	}
+	
+	pass->count = 0;
+}
+
 /**
 	@relates window_s
 	@fn void window_t__putOnCamera(Window_t *self, Entity_t *content)
@@ -34,51 +378,144 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 	@param self Object pointer
 	@param content Element pointer
 	@return void
+	
+	@note Drawing is deferred to the next update where quads are rendered by batch.
+	An entity whose image failed to load only casts its light
 */
 void window_t__putOnCamera(Window_t *self, Entity_t *content)
 {
+	SDL_Rect	   clip;
 	SDL_FRect	  rect;
 	SDL_FRect	  shadowrect;
 	SDL_Texture	*shadow = NULL;
+	SDL_Texture	*texture = NULL;
 
-	rect = content->entity.getTextureRect(content);
-	shadow = content->entity.getLighting(content);
-	shadowrect = content->entity.getLightingRect(content);
+	clip = content->entity.vtable->getTextureClip(content);
+	rect = content->entity.vtable->getTextureRect(content);
+	shadow = content->entity.vtable->getLighting(content);
+	shadowrect = content->entity.vtable->getLightingRect(content);
+	texture = content->entity.vtable->getTexture(content);
 
 	if (shadow)
+		window_t__queue(&(self->window.camera.lights), shadow, NULL, &shadowrect);
+	
+	if (texture)
+		window_t__queue(&(self->window.camera.sprites), texture, &clip, &rect);
+}
+
+/**
+	@relates window_s
+	@fn void window_t__putRect(Window_t *self, SDL_FRect rect)
+	@brief Put a rect outline to draw on the window over the sprites
+	@param self Object pointer
+	@param rect Outlined area
+	@return void
+	
+	@note Drawing is deferred to the next update, after the sprites pass
+	@warning Use it only for debugging
+*/
+void window_t__putRect(Window_t *self, SDL_FRect rect)
+{
+	window_outline_t *outlines = NULL;
+	
+	outlines = &(self->window.camera.outlines);
+	
+	if (outlines->count == outlines->size)
 	{
-		SDL_SetRenderTarget(
-			self->window.renderer,
-			self->window.camera.shadow
-		);
+		outlines->size = outlines->size ? 2 * outlines->size : WINDOW_BATCH;
+		outlines->rect = realloc(outlines->rect, outlines->size * sizeof(SDL_FRect));
+	}
+	
+	outlines->rect[outlines->count++] = rect;
+}
+
+/**
+	@relates window_s
+	@fn void *window_t__frameAlloc(Window_t *self, size_t size)
+	@brief Allocate memory living until the end of the frame
+	@param self Object pointer
+	@param size Size in bytes
+	@return Memory pointer, aligned for any type
+	
+	@note A frame needing more than the arena takes extra chunks, the arena grows
+	to fit them at the next reset
+*/
+void *window_t__frameAlloc(Window_t *self, size_t size)
+{
+	size_t			 count;
+	window_align_t	 *chunk = NULL;
+	window_arena_t	 *arena = NULL;
+	
+	arena = &(self->window.arena);
+	count = (size + sizeof(window_align_t) - 1) / sizeof(window_align_t);
+	
+	if (arena->used + count <= arena->size)
+	{
+		arena->used += count;
 		
-		SDL_RenderCopyF(
-			self->window.renderer,
-			shadow,
-			NULL,
-			&shadowrect
-		);
+		return arena->data + arena->used - count;
 	}
 	
-	SDL_SetRenderTarget(
-		self->window.renderer,
-		self->window.camera.texture
-	);
+	chunk = malloc((count + 1) * sizeof(window_align_t));
+	chunk->pointer = arena->chunk;
+	arena->chunk = chunk;
+	arena->spill += count;
 	
-	SDL_RenderCopyF(
-		self->window.renderer,
-		content->entity.getTexture(content),
-		NULL,
-		&rect
-	);
+	return chunk + 1;
+}
+
+/**
+	@relates window_s
+	@fn CList_t *window_t__frameList(Window_t *self)
+	@brief Make a CList living until the end of the frame, its links come from the frame arena
+	@param self Object pointer
+	@return Chained list
 	
-#ifdef DEBUG_BOX
-	SDL_SetRenderDrawColor(self->window.renderer, 0, 255, 0, 255);
-	SDL_RenderDrawRectF(
-		self->window.renderer,
-		&rect
-	);
-#endif
+	@note Delete leaves a frame list alone, it goes away with the frame
+*/
+CList_t *window_t__frameList(Window_t *self)
+{
+	CList_t *list = NULL;
+	
+	list = self->window.vtable->frameAlloc(self, sizeof(CList_t));
+	memset(list, 0, sizeof(CList_t));
+	clist_t__ctor(list);
+	list->type = CLIST;
+	list->clist.frame = self;
+	
+	return list;
+}
+
+/**
+	@relates window_s
+	@fn void window_t__reset(Window_t *self)
+	@brief Release every frame allocation at once
+	@param self Object pointer
+	@return void
+*/
+void window_t__reset(Window_t *self)
+{
+	window_align_t	 *chunk = NULL;
+	window_arena_t	 *arena = NULL;
+	
+	arena = &(self->window.arena);
+	
+	while (arena->chunk)
+	{
+		chunk = arena->chunk;
+		arena->chunk = chunk->pointer;
+		free(chunk);
+	}
+	
+	if (arena->spill)
+	{
+		arena->size += arena->spill;
+		arena->spill = 0;
+		free(arena->data);
+		arena->data = malloc(arena->size * sizeof(window_align_t));
+	}
+	
+	arena->used = 0;
 }
 
 /**
@@ -99,6 +536,20 @@ uint8_t window_t__update(Window_t *self)
 	if (!SDL_PollEvent(&(self->window.event)))
 		self->window.event.type = SDL_FIRSTEVENT;
 	
+	self->window.drawcalls = 0;
+	window_t__flush(self, &(self->window.camera.sprites), self->window.camera.texture);
+	
+	/* Outlines go over the sprites, on the target the sprites pass left */
+	SDL_SetRenderDrawColor(self->window.renderer, 255, 0, 0, 255);
+	SDL_RenderDrawRectsF(
+		self->window.renderer,
+		self->window.camera.outlines.rect,
+		(int) self->window.camera.outlines.count
+	);
+	self->window.camera.outlines.count = 0;
+	
+	window_t__flush(self, &(self->window.camera.lights), self->window.camera.shadow);
+	
 	SDL_SetRenderTarget(self->window.renderer, NULL);
 	SDL_RenderCopyF(self->window.renderer, self->window.camera.texture, NULL, NULL);
 	SDL_RenderCopyF(self->window.renderer, self->window.camera.shadow, NULL, NULL);
@@ -118,6 +569,8 @@ uint8_t window_t__update(Window_t *self)
 	);
 	SDL_RenderClear(self->window.renderer);
 
+	window_t__reset(self);
+
 #ifdef FPS_ECO
 	SDL_Delay(16);
 #endif
@@ -149,6 +602,18 @@ uint64_t window_t__getDeltatime(Window_t *self)
 	return self->window.deltatime;
 }
 
+/**
+	@relates window_s
+	@fn size_t window_t__getDrawCalls(Window_t *self)
+	@brief Get the number of batched draw calls of the last frame
+	@param self Object pointer
+	@return Draw calls count
+*/
+size_t window_t__getDrawCalls(Window_t *self)
+{
+	return self->window.drawcalls;
+}
+
 /**
 	@relates window_s
 	@fn void window_t__setLighting(Window_t *self, SDL_Color color)
@@ -162,6 +627,20 @@ void window_t__setLighting(Window_t *self, SDL_Color color)
 	self->window.camera.lighting = color;
 }
 
+static const window_vtable_t window_vtable = {
+	&window_t__setLighting,
+	&window_t__putOnCamera,
+	&window_t__putRect,
+	&window_t__releaseTexture,
+	&window_t__update,
+	&window_t__frameAlloc,
+	&window_t__frameList,
+	&window_t__getDeltatime,
+	&window_t__getDrawCalls,
+	&window_t__getEvent,
+	&window_t__takeTexture
+};
+
 retno_t window_t__ctor(Window_t *self)
 {
 #ifdef DEBUG
@@ -187,6 +666,7 @@ retno_t window_t__ctor(Window_t *self)
 	self->window.event.type = SDL_FIRSTEVENT;
 	self->window.time = 0;
 	self->window.deltatime = 0;
+	self->window.drawcalls = 0;
 	
 	self->window.camera.rect.x = 0.0;
 	self->window.camera.rect.y = 0.0;
@@ -216,17 +696,71 @@ retno_t window_t__ctor(Window_t *self)
 	self->window.camera.lighting.b = 255;
 	self->window.camera.lighting.a = 255;
 	
-	self->window.putOnCamera = &window_t__putOnCamera;
-	self->window.update = &window_t__update;
-	self->window.getEvent = &window_t__getEvent;
-	self->window.setLighting = &window_t__setLighting;
-	self->window.getDeltatime = &window_t__getDeltatime;
+	self->window.atlas = CList();
+	self->window.textures = CList();
+	
+	self->window.arena.size = WINDOW_ARENA;
+	self->window.arena.data = malloc(self->window.arena.size * sizeof(window_align_t));
+	
+	self->window.vtable = &window_vtable;
 	
 	return SUCCESS;
 }
 
 retno_t window_t__dtor(Window_t *self)
 {
+	size_t			 i;
+	window_pass_t	  *pass = NULL;
+	window_atlas_t	 *atlas = NULL;
+	window_texture_t   *texture = NULL;
+	
+	pass = &(self->window.camera.sprites);
+	for (i = 0; i < pass->size; ++i)
+	{
+		free(pass->batch[i].vertices);
+		free(pass->batch[i].indices);
+	}
+	free(pass->batch);
+	
+	pass = &(self->window.camera.lights);
+	for (i = 0; i < pass->size; ++i)
+	{
+		free(pass->batch[i].vertices);
+		free(pass->batch[i].indices);
+	}
+	free(pass->batch);
+	
+	free(self->window.camera.outlines.rect);
+	
+	if (self->window.textures)
+	{
+		texture = self->window.textures->clist.vtable->pop(self->window.textures);
+		while (texture)
+		{
+			free(texture->path);
+			free(texture);
+			texture = self->window.textures->clist.vtable->pop(self->window.textures);
+		}
+		
+		delete(self->window.textures);
+	}
+	
+	if (self->window.atlas)
+	{
+		atlas = self->window.atlas->clist.vtable->pop(self->window.atlas);
+		while (atlas)
+		{
+			SDL_DestroyTexture(atlas->texture);
+			free(atlas);
+			atlas = self->window.atlas->clist.vtable->pop(self->window.atlas);
+		}
+		
+		delete(self->window.atlas);
+	}
+	
+	window_t__reset(self);
+	free(self->window.arena.data);
+	
 	if (self->window.camera.texture)
 		SDL_DestroyTexture(self->window.camera.texture);
 	
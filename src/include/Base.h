@@ -44,18 +44,45 @@ typedef enum type {
 	CLIST	 = 0x1,
 	QTREE	 = 0x2,
 	WINDOW	= 0x4,
-	ENTITY	= 0x8
+	ENTITY	= 0x8,
+	LTREE	 = 0x10,
+	GRID	  = 0x20,
+	SPLIT	 = 0x40,
+	SWEEP	 = 0x80,
+	BATCH	 = 0x100,
+	CVECTOR   = 0x200,
+	SCHEDULER = 0x400
 } type_t;
 
+typedef union batch_u Batch_t;
 typedef union clist_u CList_t;
+typedef union cvector_u CVector_t;
 typedef union entity_u Entity_t;
-typedef union qtree_u QTree_t;
+typedef union space_u Grid_t;
+typedef union space_u LTree_t;
+typedef union space_u QTree_t;
+typedef union scheduler_u Scheduler_t;
+typedef union space_u Space_t;
+typedef union space_u Split_t;
+typedef union sweep_u Sweep_t;
 typedef union window_u Window_t;
 
 #define BASE_CLASS \
 type_t type;
 
+#define BASE_SLAB 64
+#define BASE_TYPES 16
+
+typedef struct base_stats {
+	size_t live;
+	size_t peak;
+	size_t capacity;
+} base_stats_t;
+
 void *new(type_t type, ...);
 void delete(void *ptr);
+void reserve(type_t type, size_t count);
+base_stats_t stats(type_t type);
+void release(void);
 
 #endif/*__BASE_H__*/
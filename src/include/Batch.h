@@ -0,0 +1,81 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Batch.h
+*/
+
+#ifndef __BATCH_H__
+#define __BATCH_H__
+
+#include <Base.h>
+#include <layer.h>
+#include <SDL2/SDL.h>
+#include <stdint.h>
+
+#define Batch(LAYER) new(BATCH, LAYER)
+#define BATCH_SIZE 64
+
+typedef struct batch_pair {
+	size_t query;
+	Entity_t *content;
+} batch_pair_t;
+
+typedef struct batch_query {
+	Batch_t *batch;
+	size_t query;
+} batch_query_t;
+
+typedef struct batch_vtable {
+	size_t	  (*add)(Batch_t *self, SDL_FRect rect);
+	void		(*push)(Batch_t *self, size_t query, Entity_t *content);
+	void		(*reserve)(Batch_t *self, size_t count);
+	size_t	  (*run)(Batch_t *self, Space_t *space);
+	Entity_t	**(*span)(Batch_t *self, size_t query, size_t *count);
+	void		(*empty)(Batch_t *self);
+} batch_vtable_t;
+
+#define BATCH_CLASS \
+SDL_FRect	 *rect;\
+size_t		*start;\
+batch_pair_t  *pair;\
+Entity_t	  **result;\
+size_t		*active;\
+layer_t	   layer;\
+size_t		count;\
+size_t		size;\
+size_t		pairs;\
+size_t		room;\
+size_t		used;\
+size_t		depth;\
+const batch_vtable_t *vtable;
+
+typedef struct batch_s {
+	BASE_CLASS
+	BATCH_CLASS
+} batch_t;
+
+union batch_u {
+	type_t type;
+	batch_t batch;
+};
+
+retno_t batch_t__ctor(Batch_t *self);
+retno_t batch_t__dtor(Batch_t *self);
+
+#endif/*__BATCH_H__*/
@@ -25,23 +25,36 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <Base.h>
 #include <layer.h>
+#include <stdint.h>
 
 #define CList() new(CLIST)
+#define CLIST_SLAB 256
 
 typedef struct clist_block {
 	void *content;
 	struct clist_block *next;
+	struct clist_block *prev;
+	uint8_t intrusive;
 } clist_block_t;
 
+typedef struct clist_slab clist_slab_t;
+
+typedef struct clist_vtable {
+	void *(*pop)(CList_t *self);
+	void (*empty)(CList_t *self);
+	void (*push)(CList_t *self, void *content);
+	void (*remove)(CList_t *self, void *content);
+	void (*attach)(CList_t *self, clist_block_t *block, void *content);
+	void (*unlink)(CList_t *self, clist_block_t *block);
+	clist_block_t *(*link)(CList_t *self, void *content);
+	void *(*iter)(CList_t *self, clist_block_t **block);
+	void (*entityUpdateAndDraw)(CList_t *self, layer_t updateLayer, layer_t drawLayer);
+} clist_vtable_t;
+
 #define CLIST_CLASS \
 clist_block_t *head;\
-\
-void *(*pop)(CList_t *self);\
-void (*empty)(CList_t *self);\
-void (*push)(CList_t *self, void *content);\
-void (*remove)(CList_t *self, void *content);\
-void *(*iter)(CList_t *self, clist_block_t **block);\
-void (*entityUpdateAndDraw)(CList_t *self, layer_t updateLayer, layer_t drawLayer);
+Window_t *frame;\
+const clist_vtable_t *vtable;
 
 typedef struct clist_s {
 	BASE_CLASS
@@ -53,6 +66,7 @@ union clist_u {
 	clist_t clist;
 };
 
+void clist_t__release(void);
 retno_t clist_t__ctor(CList_t *self);
 retno_t clist_t__dtor(CList_t *self);
 
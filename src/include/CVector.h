@@ -0,0 +1,65 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file CVector.h
+*/
+
+#ifndef __CVECTOR_H__
+#define __CVECTOR_H__
+
+#include <Base.h>
+#include <layer.h>
+#include <stddef.h>
+
+#define CVector() new(CVECTOR)
+#define CVECTOR_SIZE 64
+
+typedef struct cvector_vtable {
+	void *(*pop)(CVector_t *self);
+	void *(*get)(CVector_t *self, size_t index);
+	void *(*iter)(CVector_t *self, size_t *index);
+	void *(*removeAt)(CVector_t *self, size_t index);
+	void (*empty)(CVector_t *self);
+	void (*push)(CVector_t *self, void *content);
+	void (*remove)(CVector_t *self, void *content);
+	void (*reserve)(CVector_t *self, size_t size);
+	void (*sort)(CVector_t *self, int (*compare)(const void *, const void *));
+	void (*entityUpdateAndDraw)(CVector_t *self, layer_t updateLayer, layer_t drawLayer);
+} cvector_vtable_t;
+
+#define CVECTOR_CLASS \
+void **content;\
+size_t count;\
+size_t size;\
+const cvector_vtable_t *vtable;
+
+typedef struct cvector_s {
+	BASE_CLASS
+	CVECTOR_CLASS
+} cvector_t;
+
+union cvector_u {
+	type_t type;
+	cvector_t cvector;
+};
+
+retno_t cvector_t__ctor(CVector_t *self);
+retno_t cvector_t__dtor(CVector_t *self);
+
+#endif/*__CVECTOR_H__*/
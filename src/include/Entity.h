@@ -28,6 +28,7 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #include <math.h>
 #include <SDL2/SDL.h>
 #include <stdint.h>
+#include <Window.h>
 
 #define SIGMOID(VAR) (1 / (1 + exp(-(VAR))))
 #define MODULUS(XVAR, YVAR) (sqrt((XVAR) * (XVAR) + (YVAR) * (YVAR)))
@@ -51,6 +52,9 @@ typedef enum action {
 } action_t;
 
 #define ENTITYSPEED 0.1
+#define ENTITYBOOST 2.0
+#define ENTITYSKIN 0.01
+#define ENTITYCONTACTS 64
 #define Entity(WINDOW, XPOS, YPOS, LAYER, RECT, PATH) new(ENTITY, WINDOW, (float) (XPOS), (float) (YPOS), LAYER, RECT, PATH)
 
 typedef struct entity_position {
@@ -61,7 +65,7 @@ typedef struct entity_position {
 
 typedef struct entity_graphics {
 	char *path;
-	SDL_Texture *texture;
+	window_texture_t *texture;
 	float width;
 	float height;
 	SDL_Texture *shadow;
@@ -93,30 +97,68 @@ typedef struct entity_transition {
 	entity_state_t *to;
 } entity_transition_t;
 
+typedef struct entity_node {
+	Space_t *leaf;
+	size_t slot;
+	uint8_t dirty;
+	size_t mark;
+	SDL_FPoint from;
+} entity_node_t;
+
+typedef struct entity_contact {
+	Entity_t **other;
+	size_t count;
+	size_t run;
+} entity_contact_t;
+
+typedef struct entity_hit {
+	Entity_t *self;
+	SDL_FRect rect;
+	SDL_FPoint move;
+	float time;
+	uint8_t axis;
+	size_t count;
+	size_t size;
+	Entity_t **other;
+	Entity_t *buffer[ENTITYCONTACTS];
+} entity_hit_t;
+
+typedef struct entity_vtable {
+	void		   (*draw)(Entity_t *self);
+	void		   (*setSpace)(Entity_t *self, Space_t *space);
+	void		   (*setNode)(Entity_t *self, Space_t *leaf, size_t slot);
+	void		   (*setDirty)(Entity_t *self, uint8_t dirty);
+	void		   (*setMark)(Entity_t *self, size_t mark);
+	void		   (*setContacts)(Entity_t *self, size_t run, Entity_t **other, size_t count);
+	void		   (*setDeltaPosition)(Entity_t *self, float dx, float dy);
+	void		   (*setLighting)(Entity_t *self, float radius, SDL_Color color);
+	void		   (*transition)(Entity_t *self, uint8_t from, uint32_t type, int32_t sym, action_t action, uint8_t to);
+	uint8_t		(*update)(Entity_t *self);
+	CList_t		*(*states)(Entity_t *self);
+	layer_t		(*getLayer)(Entity_t *self);
+	Space_t		*(*getSpace)(Entity_t *self);
+	entity_node_t  (*getNode)(Entity_t *self);
+	SDL_Rect	   (*getTextureClip)(Entity_t *self);
+	SDL_FRect	  (*getHitbox)(Entity_t *self);
+	SDL_FRect	  (*getTextureRect)(Entity_t *self);
+	SDL_FRect	  (*getLightingRect)(Entity_t *self);
+	SDL_FPoint	 (*getPosition)(Entity_t *self);
+	SDL_Texture	*(*getTexture)(Entity_t *self);
+	SDL_Texture	*(*getLighting)(Entity_t *self);
+} entity_vtable_t;
+
 #define ENTITY_CLASS \
-QTree_t			  *qtree;\
+Space_t			  *space;\
 Window_t			 *window;\
 entity_delta_t	   delta;\
 entity_state_t	   *state;\
+entity_state_t	   origin;\
+entity_node_t		node;\
+entity_contact_t	 contact;\
 entity_health_t	  health;\
 entity_position_t	position;\
 entity_graphics_t	graphics;\
-\
-void		   (*draw)(Entity_t *self);\
-void		   (*setQTree)(Entity_t *self, QTree_t *qtree);\
-void		   (*setDeltaPosition)(Entity_t *self, float dx, float dy);\
-void		   (*setLighting)(Entity_t *self, float radius, SDL_Color color);\
-void		   (*transition)(Entity_t *self, uint8_t from, uint32_t type, int32_t sym, action_t action, uint8_t to);\
-uint8_t		(*update)(Entity_t *self);\
-CList_t		*(*states)(Entity_t *self);\
-layer_t		(*getLayer)(Entity_t *self);\
-QTree_t		*(*getQTree)(Entity_t *self);\
-SDL_FRect	  (*getHitbox)(Entity_t *self);\
-SDL_FRect	  (*getTextureRect)(Entity_t *self);\
-SDL_FRect	  (*getLightingRect)(Entity_t *self);\
-SDL_FPoint	 (*getPosition)(Entity_t *self);\
-SDL_Texture	*(*getTexture)(Entity_t *self);\
-SDL_Texture	*(*getLighting)(Entity_t *self);\
+const entity_vtable_t *vtable;
 
 typedef struct entity_s {
 	BASE_CLASS
@@ -0,0 +1,73 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Grid.h
+	@note Included through Space.h
+*/
+
+#ifndef __GRID_H__
+#define __GRID_H__
+
+#include <Base.h>
+#include <layer.h>
+#include <SDL2/SDL.h>
+#include <stdint.h>
+
+#define Grid(CELL) new(GRID, (double) (CELL), (size_t) GRID_BUCKETS)
+#define GridConfig(CELL, BUCKETS) new(GRID, (double) (CELL), (size_t) (BUCKETS))
+#define GRID_BUCKETS 1024
+#define GRID_LOAD 2
+#define GRID_SIZE 64
+
+typedef struct grid_item {
+	Entity_t *content;
+	int32_t x;
+	int32_t y;
+	size_t slot;
+} grid_item_t;
+
+typedef struct grid_bucket {
+	size_t *item;
+	size_t count;
+	size_t size;
+} grid_bucket_t;
+
+#define GRID_CLASS \
+grid_item_t   *item;\
+grid_bucket_t *bucket;\
+size_t		count;\
+size_t		size;\
+size_t		buckets;\
+float		 cell;\
+SDL_FPoint	margin;\
+layer_t	   layer;\
+Entity_t	  **dirty;\
+size_t		marked;\
+size_t		reserved;
+
+typedef struct grid_s {
+	BASE_CLASS
+	SPACE_CLASS
+	GRID_CLASS
+} grid_t;
+
+retno_t grid_t__ctor(Grid_t *self);
+retno_t grid_t__dtor(Grid_t *self);
+
+#endif/*__GRID_H__*/
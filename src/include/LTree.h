@@ -0,0 +1,75 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file LTree.h
+	@note Included through Space.h
+*/
+
+#ifndef __LTREE_H__
+#define __LTREE_H__
+
+#include <Base.h>
+#include <layer.h>
+#include <SDL2/SDL.h>
+#include <stdint.h>
+
+#define LTree(RECT) new(LTREE, RECT)
+#define LTREE_BITS 16
+#define LTREE_DEPTH 8
+#define LTREE_SIZE 64
+
+typedef struct ltree_cell {
+	uint32_t code;
+	Entity_t *content;
+} ltree_cell_t;
+
+typedef struct ltree_query {
+	SDL_FRect rect;
+	layer_t layer;
+	space_visit_t callback;
+	void *data;
+	uint32_t min[2];
+	uint32_t max[2];
+	uint32_t from;
+	uint32_t to;
+	uint8_t pending;
+} ltree_query_t;
+
+#define LTREE_CLASS \
+ltree_cell_t *cell;\
+ltree_cell_t *swap;\
+size_t	   count;\
+size_t	   size;\
+size_t	   holes;\
+uint8_t	  moved;\
+uint8_t	  sorted;\
+SDL_FRect	rect;\
+SDL_FPoint   margin;\
+layer_t	  layer;
+
+typedef struct ltree_s {
+	BASE_CLASS
+	SPACE_CLASS
+	LTREE_CLASS
+} ltree_t;
+
+retno_t ltree_t__ctor(LTree_t *self);
+retno_t ltree_t__dtor(LTree_t *self);
+
+#endif/*__LTREE_H__*/
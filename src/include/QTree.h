@@ -18,36 +18,73 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 /**
 	@file QTree.h
+	@note Included through Space.h
 */
 
 #ifndef __QTREE_H__
 #define __QTREE_H__
 
 #include <Base.h>
+#include <layer.h>
 #include <SDL2/SDL.h>
-#include <stdint.h>
 
-#define QTree(RECT) new(QTREE, RECT)
+#define QTree(RECT) new(QTREE, RECT, (size_t) QTREE_CAPACITY, (size_t) QTREE_DEPTH, 0)
+#define QTreeConfig(RECT, CAPACITY, DEPTH) new(QTREE, RECT, (size_t) (CAPACITY), (size_t) (DEPTH), 0)
+#define QTreeLoose(RECT, CAPACITY, DEPTH) new(QTREE, RECT, (size_t) (CAPACITY), (size_t) (DEPTH), 1)
+#define QTREE_SLAB 64
+#define QTREE_CAPACITY 8
+#define QTREE_DEPTH 12
+#define QTREE_GROWTH 32
+
+typedef struct qtree_pool qtree_pool_t;
+typedef struct qtree_slab qtree_slab_t;
+
+typedef struct qtree_near {
+	float distance;
+	QTree_t *node;
+	Entity_t *content;
+} qtree_near_t;
 
 #define QTREE_CLASS \
+QTree_t	  *parent;\
 QTree_t	  *tree[4];\
-Entity_t	 *content[4];\
+Entity_t	 **content;\
+size_t	   count;\
+size_t	   size;\
+size_t	   depth;\
 SDL_FRect	rect;\
-\
-void	   (*update)(QTree_t *self);\
-void	   (*draw)(QTree_t *self, Window_t *window);\
-void	   (*insert)(QTree_t *self, Entity_t *content);\
-CList_t	*(*fetch)(QTree_t *self, SDL_FRect rect);\
-uint8_t	(*remove)(QTree_t *self, Entity_t *content);
+layer_t	  layer;\
+qtree_pool_t *pool;
 
 typedef struct qtree_s {
 	BASE_CLASS
+	SPACE_CLASS
 	QTREE_CLASS
 } qtree_t;
 
-union qtree_u {
-	type_t type;
-	qtree_t qtree;
+typedef struct qtree_bulk {
+	Entity_t *content;
+	layer_t layer;
+	SDL_FPoint point;
+	SDL_FRect rect;
+} qtree_bulk_t;
+
+struct qtree_pool {
+	QTree_t *root;
+	QTree_t *free;
+	qtree_slab_t *slab;
+	size_t capacity;
+	size_t depth;
+	float width;
+	float height;
+	size_t count;
+	size_t size;
+	Entity_t **dirty;
+	qtree_near_t *queue;
+	size_t queued;
+	qtree_near_t *best;
+	size_t kept;
+	SDL_FRect reach;
 };
 
 retno_t qtree_t__ctor(QTree_t *self);
@@ -0,0 +1,80 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Scheduler.h
+*/
+
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include <Base.h>
+#include <layer.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define Scheduler() new(SCHEDULER)
+#define SCHEDULER_PASSES 32
+#define SCHEDULER_SIZE 64
+
+typedef struct scheduler_pass {
+	layer_t update;
+	layer_t draw;
+	size_t start;
+	size_t count;
+	size_t next;
+} scheduler_pass_t;
+
+typedef struct scheduler_item {
+	Entity_t *content;
+	layer_t layer;
+	uint32_t passes;
+} scheduler_item_t;
+
+typedef struct scheduler_vtable {
+	size_t	(*addPass)(Scheduler_t *self, layer_t update, layer_t draw);
+	void	  (*run)(Scheduler_t *self, CVector_t *vector);
+} scheduler_vtable_t;
+
+#define SCHEDULER_CLASS \
+scheduler_pass_t	pass[SCHEDULER_PASSES];\
+uint32_t			low[256];\
+uint32_t			high[256];\
+size_t			  passes;\
+scheduler_item_t	*item;\
+scheduler_item_t	*entry;\
+size_t			  count;\
+size_t			  size;\
+size_t			  entries;\
+size_t			  room;\
+const scheduler_vtable_t *vtable;
+
+typedef struct scheduler_s {
+	BASE_CLASS
+	SCHEDULER_CLASS
+} scheduler_t;
+
+union scheduler_u {
+	type_t type;
+	scheduler_t scheduler;
+};
+
+retno_t scheduler_t__ctor(Scheduler_t *self);
+retno_t scheduler_t__dtor(Scheduler_t *self);
+
+#endif/*__SCHEDULER_H__*/
@@ -0,0 +1,120 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Space.h
+	@brief Spatial index interface shared by the Grid, LTree, QTree and Split backends
+*/
+
+#ifndef __SPACE_H__
+#define __SPACE_H__
+
+#include <Base.h>
+#include <layer.h>
+#include <SDL2/SDL.h>
+#include <stdint.h>
+
+#define SPACE_REACH 1048576
+#define SPACE_STEP 64
+
+typedef void (*space_visit_t)(Entity_t *content, void *data);
+
+typedef struct space_ray {
+	SDL_FPoint from;
+	SDL_FPoint move;
+	layer_t layer;
+	float time;
+	Entity_t *hit;
+} space_ray_t;
+
+typedef struct space_circle {
+	SDL_FPoint center;
+	float limit;
+	space_visit_t callback;
+	void *data;
+} space_circle_t;
+
+typedef struct space_near {
+	SDL_FPoint point;
+	float limit;
+	Entity_t **result;
+	size_t count;
+	size_t found;
+} space_near_t;
+
+/* Backends share one method table layout, operations a backend lacks answer through its visit */
+typedef struct space_vtable {
+	void	   (*update)(Space_t *self);
+	void	   (*draw)(Space_t *self, Window_t *window);
+	void	   (*insert)(Space_t *self, Entity_t *content);
+	void	   (*build)(Space_t *self, Entity_t **content, size_t count);
+	void	   (*mark)(Space_t *self, Entity_t *content);
+	void	   (*visit)(Space_t *self, SDL_FRect rect, layer_t layer, space_visit_t callback, void *data);
+	CList_t	*(*fetch)(Space_t *self, SDL_FRect rect);
+	CList_t	*(*fetchLayer)(Space_t *self, SDL_FRect rect, layer_t layer);
+	void	   (*query)(Space_t *self, Batch_t *batch);
+	void	   (*fetchVector)(Space_t *self, SDL_FRect rect, layer_t layer, CVector_t *vector);
+	CList_t	*(*fetchFrame)(Space_t *self, SDL_FRect rect, layer_t layer, Window_t *window);
+	uint8_t	(*remove)(Space_t *self, Entity_t *content);
+	
+	/* Exact in the QTree, the other backends fall back on visit */
+	void	   (*move)(QTree_t *self, Entity_t *content, SDL_FPoint from);
+	void	   (*visitCircle)(QTree_t *self, SDL_FPoint center, float radius, layer_t layer, space_visit_t callback, void *data);
+	size_t	 (*nearest)(QTree_t *self, SDL_FPoint point, layer_t layer, Entity_t **result, size_t count);
+	Entity_t   *(*raycast)(QTree_t *self, SDL_FPoint from, SDL_FPoint to, layer_t layer, float *time);
+} space_vtable_t;
+
+#define SPACE_CLASS \
+uint8_t	  loose;\
+const space_vtable_t *vtable;
+
+typedef struct space_s {
+	BASE_CLASS
+	SPACE_CLASS
+} space_t;
+
+void space_t__collect(Entity_t *content, void *data);
+void space_t__store(Entity_t *content, void *data);
+void space_t__gather(Entity_t *content, void *data);
+CList_t *space_t__fetch(Space_t *self, SDL_FRect rect);
+CList_t *space_t__fetchLayer(Space_t *self, SDL_FRect rect, layer_t layer);
+CList_t *space_t__fetchFrame(Space_t *self, SDL_FRect rect, layer_t layer, Window_t *window);
+void space_t__fetchVector(Space_t *self, SDL_FRect rect, layer_t layer, CVector_t *vector);
+void space_t__query(Space_t *self, Batch_t *batch);
+float space_t__distance(SDL_FRect rect, SDL_FPoint point);
+uint8_t space_t__slab(SDL_FRect rect, SDL_FPoint from, SDL_FPoint move, float *enter, float *leave);
+void space_t__move(Space_t *self, Entity_t *content, SDL_FPoint from);
+void space_t__visitCircle(Space_t *self, SDL_FPoint center, float radius, layer_t layer, space_visit_t callback, void *data);
+size_t space_t__nearest(Space_t *self, SDL_FPoint point, layer_t layer, Entity_t **result, size_t count);
+Entity_t *space_t__raycast(Space_t *self, SDL_FPoint from, SDL_FPoint to, layer_t layer, float *time);
+
+#include <Grid.h>
+#include <LTree.h>
+#include <QTree.h>
+#include <Split.h>
+
+union space_u {
+	type_t type;
+	space_t space;
+	grid_t grid;
+	ltree_t ltree;
+	qtree_t qtree;
+	split_t split;
+};
+
+#endif/*__SPACE_H__*/
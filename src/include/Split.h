@@ -0,0 +1,44 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Split.h
+	@note Included through Space.h
+*/
+
+#ifndef __SPLIT_H__
+#define __SPLIT_H__
+
+#include <Base.h>
+
+#define Split(STATIC, DYNAMIC) new(SPLIT, (Space_t *) (STATIC), (Space_t *) (DYNAMIC))
+
+#define SPLIT_CLASS \
+Space_t	  *fixed;\
+Space_t	  *dynamic;
+
+typedef struct split_s {
+	BASE_CLASS
+	SPACE_CLASS
+	SPLIT_CLASS
+} split_t;
+
+retno_t split_t__ctor(Split_t *self);
+retno_t split_t__dtor(Split_t *self);
+
+#endif/*__SPLIT_H__*/
@@ -0,0 +1,83 @@
+/*
+c89 2d game engine build with sdl2.
+Copyright (C) 2025 Programind
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+/**
+	@file Sweep.h
+*/
+
+#ifndef __SWEEP_H__
+#define __SWEEP_H__
+
+#include <Base.h>
+#include <layer.h>
+#include <SDL2/SDL.h>
+#include <stdint.h>
+
+#define Sweep(WINDOW) new(SWEEP, WINDOW)
+#define SWEEP_SIZE 64
+
+typedef struct sweep_box {
+	uint32_t key;
+	SDL_FRect rect;
+	layer_t layer;
+	uint8_t mover;
+	size_t count;
+	Entity_t *content;
+} sweep_box_t;
+
+typedef struct sweep_pair {
+	size_t mover;
+	Entity_t *other;
+} sweep_pair_t;
+
+typedef struct sweep_vtable {
+	size_t   (*run)(Sweep_t *self, CList_t *list, layer_t movers);
+	size_t   (*runVector)(Sweep_t *self, CVector_t *vector, layer_t movers);
+} sweep_vtable_t;
+
+#define SWEEP_CLASS \
+Window_t	  *window;\
+sweep_box_t   *box;\
+sweep_box_t   *spare;\
+sweep_pair_t  *pair;\
+Entity_t	  **contact;\
+size_t		*moving;\
+size_t		*still;\
+size_t		count;\
+size_t		size;\
+size_t		pairs;\
+size_t		room;\
+size_t		runs;\
+const sweep_vtable_t *vtable;
+
+typedef struct sweep_s {
+	BASE_CLASS
+	SWEEP_CLASS
+} sweep_t;
+
+union sweep_u {
+	type_t type;
+	sweep_t sweep;
+};
+
+size_t sweep_t__clock(void);
+void sweep_t__expire(void);
+retno_t sweep_t__ctor(Sweep_t *self);
+retno_t sweep_t__dtor(Sweep_t *self);
+
+#endif/*__SWEEP_H__*/
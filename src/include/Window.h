@@ -24,31 +24,107 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #define __WINDOW_H__
 
 #include <Base.h>
+#include <CList.h>
 #include <SDL2/SDL.h>
 #include <stdint.h>
 
 #define Window() new(WINDOW)
+#define WINDOW_ATLAS 1024
+#define WINDOW_GUTTER 1
+#define WINDOW_BATCH 64
+#define WINDOW_ARENA 4096
+
+typedef struct window_batch {
+	int count;
+	int size;
+	float width;
+	float height;
+	int *indices;
+	SDL_Vertex *vertices;
+	SDL_Texture *texture;
+} window_batch_t;
+
+typedef struct window_pass {
+	size_t count;
+	size_t size;
+	window_batch_t *batch;
+} window_pass_t;
+
+typedef struct window_outline {
+	size_t count;
+	size_t size;
+	SDL_FRect *rect;
+} window_outline_t;
 
 typedef struct window_camera {
 	SDL_FRect rect;
 	SDL_Texture *texture;
 	SDL_Texture *shadow;
 	SDL_Color lighting;
+	window_pass_t sprites;
+	window_pass_t lights;
+	window_outline_t outlines;
 } window_camera_t;
 
+typedef union window_align {
+	void *pointer;
+	double number;
+	long integer;
+} window_align_t;
+
+typedef struct window_arena {
+	window_align_t *data;
+	window_align_t *chunk;
+	size_t used;
+	size_t size;
+	size_t spill;
+} window_arena_t;
+
+typedef struct window_atlas {
+	int x;
+	int y;
+	int shelf;
+	int width;
+	int height;
+	SDL_Texture *texture;
+} window_atlas_t;
+
+typedef struct window_texture {
+	char *path;
+	size_t count;
+	float width;
+	float height;
+	SDL_Rect rect;
+	SDL_Texture *texture;
+	clist_block_t link;
+} window_texture_t;
+
+typedef struct window_vtable {
+	void		 (*setLighting)(Window_t *self, SDL_Color color);
+	void		 (*putOnCamera)(Window_t *self, Entity_t *content);
+	void		 (*putRect)(Window_t *self, SDL_FRect rect);
+	void		 (*releaseTexture)(Window_t *self, window_texture_t *texture);
+	uint8_t	  (*update)(Window_t *self);
+	void		 *(*frameAlloc)(Window_t *self, size_t size);
+	CList_t	  *(*frameList)(Window_t *self);
+	uint64_t	 (*getDeltatime)(Window_t *self);
+	size_t	   (*getDrawCalls)(Window_t *self);
+	SDL_Event	(*getEvent)(Window_t *self);
+	window_texture_t	*(*takeTexture)(Window_t *self, char *path);
+} window_vtable_t;
+
 #define WINDOW_CLASS \
 uint64_t		   time;\
 uint64_t		   deltatime;\
+size_t			 drawcalls;\
 SDL_Event		  event;\
 SDL_Window		 *window;\
 SDL_Renderer	   *renderer;\
 window_camera_t	camera;\
-\
-void		 (*setLighting)(Window_t *self, SDL_Color color);\
-void		 (*putOnCamera)(Window_t *self, Entity_t *content);\
-uint8_t	  (*update)(Window_t *self);\
-uint64_t	 (*getDeltatime)(Window_t *self);\
-SDL_Event	(*getEvent)(Window_t *self);
+CList_t			*atlas;\
+CList_t			*textures;\
+window_arena_t	 arena;\
+const window_vtable_t *vtable;
 
 typedef struct window_s {
 	BASE_CLASS
@@ -24,9 +24,13 @@ along with this program.  If not, see <https://www.gnu.org/licenses/>.
 #define __ENGINE_H__
 
 #include <Base.h>
+#include <Batch.h>
 #include <CList.h>
+#include <CVector.h>
 #include <Entity.h>
-#include <QTree.h>
+#include <Scheduler.h>
+#include <Space.h>
+#include <Sweep.h>
 #include <Window.h>
 
 #endif/*__ENGINE_H__*/
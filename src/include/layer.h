@@ -44,7 +44,8 @@ typedef enum layer {
 	LAYER_13	= 0x1000,
 	LAYER_14	= 0x2000,
 	LAYER_15	= 0x4000,
-	LAYER_16	= 0x8000
+	LAYER_16	= 0x8000,
+	ALL_LAYER	= 0xFFFF
 } layer_t;
 
 #endif/*__LAYER_H__*/
@@ -0,0 +1,246 @@
+#include <engine.h>
+#include <stdio.h>
+
+#define CHECK(TEST) check((TEST), #TEST, __LINE__)
+#define TILE "./assets/Tiles/tile_0028.png"
+
+static int failed = 0;
+
+static void check(int test, const char *text, int line)
+{
+	if (!test)
+	{
+		fprintf(stderr, "test/space.c:%d: %s\n", line, text);
+		failed++;
+	}
+}
+
+/* Move an element, remove the neighbour swapped over it, then remove the mover */
+static void qtree_remove_mover(Window_t *window)
+{
+	SDL_FRect	rect = { 0, 0, 16, 16 };
+	SDL_FRect	area = { 0, 0, 400, 250 };
+	Space_t	  *tree = QTree(area);
+	Entity_t	 *a = Entity(window, 32, 32, LAYER_01, rect, TILE);
+	Entity_t	 *c = Entity(window, 64, 64, LAYER_01, rect, TILE);
+
+	tree->space.vtable->insert(tree, c);
+	tree->space.vtable->insert(tree, a);
+	a->entity.vtable->setDeltaPosition(a, 1, 0);
+	tree->space.vtable->remove(tree, c);
+	CHECK(a->entity.vtable->getNode(a).dirty);
+	tree->space.vtable->remove(tree, a);
+
+	CHECK(!a->entity.vtable->getNode(a).dirty);
+	CHECK(tree->qtree.pool->count == 0);
+	tree->space.vtable->update(tree);
+
+	delete(a);
+	delete(c);
+	delete(tree);
+}
+
+/* Same on a grid, the swapped neighbour keeps its place in the dirty set */
+static void grid_remove_mover(Window_t *window)
+{
+	SDL_FRect	rect = { 0, 0, 16, 16 };
+	Space_t	  *grid = Grid(32);
+	Entity_t	 *a = Entity(window, 32, 32, LAYER_01, rect, TILE);
+	Entity_t	 *c = Entity(window, 64, 64, LAYER_01, rect, TILE);
+
+	grid->space.vtable->insert(grid, c);
+	grid->space.vtable->insert(grid, a);
+	a->entity.vtable->setDeltaPosition(a, 1, 0);
+	grid->space.vtable->remove(grid, c);
+	CHECK(a->entity.vtable->getNode(a).dirty);
+	grid->space.vtable->remove(grid, a);
+
+	CHECK(!a->entity.vtable->getNode(a).dirty);
+	CHECK(grid->grid.marked == 0);
+	grid->space.vtable->update(grid);
+
+	delete(a);
+	delete(c);
+	delete(grid);
+}
+
+/* A static element moving twice in a frame enters the dynamic dirty set once, a dynamic mover stays in it */
+static void split_transition(Window_t *window, Space_t *fixed)
+{
+	SDL_FRect	rect = { 0, 0, 16, 16 };
+	SDL_FRect	area = { 0, 0, 400, 250 };
+	Space_t	  *split = Split(fixed, QTree(area));
+	Space_t	  *dynamic = split->split.dynamic;
+	Entity_t	 *a = Entity(window, 32, 32, LAYER_01, rect, TILE);
+	Entity_t	 *b = Entity(window, 64, 64, LAYER_01, rect, TILE);
+	SDL_FPoint   from;
+	
+	split->space.vtable->build(split, &a, 1);
+	split->space.vtable->insert(split, b);
+	from = a->entity.vtable->getPosition(a);
+	a->entity.vtable->setDeltaPosition(a, 1, 0);
+	a->entity.vtable->setDeltaPosition(a, 1, 0);
+	b->entity.vtable->setDeltaPosition(b, 1, 0);
+	
+	CHECK(a->entity.vtable->getSpace(a) == split);
+	CHECK(a->entity.vtable->getNode(a).dirty);
+	CHECK(a->entity.vtable->getNode(a).from.x == from.x);
+	CHECK(b->entity.vtable->getNode(b).dirty);
+	CHECK(dynamic->qtree.pool->count == 2);
+	
+	split->space.vtable->update(split);
+	b->entity.vtable->setDeltaPosition(b, 1, 0);
+	CHECK(b->entity.vtable->getNode(b).dirty);
+	CHECK(dynamic->qtree.pool->count == 1);
+	
+	split->space.vtable->remove(split, a);
+	split->space.vtable->remove(split, b);
+	CHECK(dynamic->qtree.pool->count == 0);
+	split->space.vtable->update(split);
+	
+	delete(a);
+	delete(b);
+	delete(split);
+}
+
+/* Contacts of a mover left out of the next run, or of a run missing a deleted entity, are stale, the sweep may go first */
+static void sweep_stale_contacts(Window_t *window)
+{
+	SDL_FRect	rect = { 0, 0, 16, 16 };
+	Sweep_t	  *sweep = Sweep(window);
+	CVector_t	*vector = CVector();
+	Entity_t	 *a = Entity(window, 32, 32, LAYER_01, rect, TILE);
+	Entity_t	 *b = Entity(window, 40, 32, LAYER_01 | LAYER_02, rect, TILE);
+
+	vector->cvector.vtable->push(vector, a);
+	vector->cvector.vtable->push(vector, b);
+	CHECK(sweep->sweep.vtable->runVector(sweep, vector, LAYER_02) == 1);
+	CHECK(b->entity.contact.count == 1 && b->entity.contact.other[0] == a);
+	CHECK(b->entity.contact.run == sweep_t__clock());
+
+	vector->cvector.vtable->remove(vector, b);
+	sweep->sweep.vtable->runVector(sweep, vector, LAYER_02);
+	CHECK(b->entity.contact.run != sweep_t__clock());
+
+	vector->cvector.vtable->push(vector, b);
+	sweep->sweep.vtable->runVector(sweep, vector, LAYER_02);
+	CHECK(b->entity.contact.run == sweep_t__clock());
+	vector->cvector.vtable->remove(vector, a);
+	delete(a);
+	CHECK(b->entity.contact.run != sweep_t__clock());
+
+	vector->cvector.vtable->empty(vector);
+	delete(sweep);
+	delete(b);
+	delete(vector);
+}
+
+/* Each query of a batch reads its own results, on a quadtree and on a grid */
+static void batch_spans(Window_t *window, Space_t *space)
+{
+	size_t	   count;
+	SDL_FRect	rect = { 0, 0, 16, 16 };
+	SDL_FRect	left = { 0, 0, 100, 100 };
+	SDL_FRect	right = { 180, 0, 50, 60 };
+	SDL_FRect	empty = { 300, 200, 10, 10 };
+	Batch_t	  *batch = Batch(LAYER_01);
+	Entity_t	 *a = Entity(window, 32, 32, LAYER_01, rect, TILE);
+	Entity_t	 *b = Entity(window, 200, 32, LAYER_01, rect, TILE);
+	Entity_t	 *c = Entity(window, 40, 40, LAYER_01, rect, TILE);
+	Entity_t	 **span = NULL;
+	
+	space->space.vtable->insert(space, a);
+	space->space.vtable->insert(space, b);
+	space->space.vtable->insert(space, c);
+	batch->batch.vtable->add(batch, left);
+	batch->batch.vtable->add(batch, right);
+	batch->batch.vtable->add(batch, empty);
+	CHECK(batch->batch.vtable->run(batch, space) == 3);
+	
+	span = batch->batch.vtable->span(batch, 0, &count);
+	CHECK(count == 2);
+	CHECK((span[0] == a && span[1] == c) || (span[0] == c && span[1] == a));
+	span = batch->batch.vtable->span(batch, 1, &count);
+	CHECK(count == 1 && span[0] == b);
+	batch->batch.vtable->span(batch, 2, &count);
+	CHECK(count == 0);
+	
+	delete(batch);
+	delete(space);
+}
+
+/* Passes draw in declaration order, entities keep the vector order within a pass */
+static void scheduler_order(Window_t *window)
+{
+	SDL_FRect		 rect = { 0, 0, 16, 16 };
+	Scheduler_t	   *scheduler = Scheduler();
+	CVector_t		 *vector = CVector();
+	Entity_t		  *a = Entity(window, 10, 0, LAYER_01, rect, TILE);
+	Entity_t		  *b = Entity(window, 20, 0, LAYER_02, rect, TILE);
+	Entity_t		  *c = Entity(window, 30, 0, LAYER_01 | LAYER_02, rect, TILE);
+	window_batch_t	*sprites = NULL;
+	
+	scheduler->scheduler.vtable->addPass(scheduler, NO_LAYER, LAYER_02);
+	scheduler->scheduler.vtable->addPass(scheduler, NO_LAYER, LAYER_01);
+	vector->cvector.vtable->push(vector, a);
+	vector->cvector.vtable->push(vector, b);
+	vector->cvector.vtable->push(vector, c);
+	scheduler->scheduler.vtable->run(scheduler, vector);
+	
+	sprites = window->window.camera.sprites.batch;
+	CHECK(window->window.camera.sprites.count == 1 && sprites->count == 4);
+	CHECK(sprites->vertices[0].position.x < sprites->vertices[4].position.x);
+	CHECK(sprites->vertices[8].position.x < sprites->vertices[0].position.x);
+	CHECK(sprites->vertices[12].position.x == sprites->vertices[4].position.x);
+	window->window.vtable->update(window);
+	
+	vector->cvector.vtable->empty(vector);
+	delete(a);
+	delete(b);
+	delete(c);
+	delete(vector);
+	delete(scheduler);
+}
+
+/* Deleting a frame list leaves the CList pool alone */
+static void frame_list_delete(Window_t *window)
+{
+	size_t	   live;
+	CList_t	  *frame = window->window.vtable->frameList(window);
+	CList_t	  *list = NULL;
+	
+	frame->clist.vtable->push(frame, window);
+	live = stats(CLIST).live;
+	delete(frame);
+	CHECK(stats(CLIST).live == live);
+	
+	list = CList();
+	CHECK(list != frame);
+	delete(list);
+	window->window.vtable->update(window);
+}
+
+int main(int argc, char *argv[])
+{
+	SDL_FRect	area = { 0, 0, 400, 250 };
+	Window_t	 *window = Window();
+
+	qtree_remove_mover(window);
+	grid_remove_mover(window);
+	split_transition(window, LTree(area));
+	split_transition(window, QTree(area));
+	split_transition(window, Grid(32));
+	sweep_stale_contacts(window);
+	batch_spans(window, QTree(area));
+	batch_spans(window, Grid(32));
+	scheduler_order(window);
+	frame_list_delete(window);
+
+	delete(window);
+	release();
+
+	if (failed)
+		fprintf(stderr, "%d check(s) failed\n", failed);
+
+	return failed != 0;
+}